@@ -21,10 +21,16 @@
 
 #include "anu/audio_buffer.h"
 #include "anu/clock.h"
+#include "anu/dac_controller.h"
 #include "anu/dco_controller.h"
+#include "anu/diagnostics.h"
+#include "anu/drum_synth.h"
 #include "anu/hardware_config.h"
+#include "anu/latency_meter.h"
 #include "anu/midi_dispatcher.h"
 #include "anu/parameter.h"
+#include "anu/profiler.h"
+#include "anu/storage.h"
 #include "anu/ui.h"
 #include "anu/voice_controller.h"
 #include "anu/voice_tuner.h"
@@ -35,11 +41,6 @@ using namespace avrlib;
 using namespace anu;
 using namespace midi;
 
-
-DAC1SS dac_1_ss;
-DAC2SS dac_2_ss;
-DACInterface dac;
-
 PitchCalibrationInput pitch_calibration_input;
 DcoOut dco_out;
 
@@ -54,94 +55,84 @@ TuningTimer tuning_timer;
 PwmOutput<3> audio_out;
 
 volatile uint8_t refresh_counter = 0;
-volatile uint16_t clock_ticks = 0;
-volatile uint8_t num_external_clock_events = 0;
 
-inline void FlushMidiOut() {
-  // Try to flush the high priority buffer first.
-  if (midi_dispatcher.readable_high_priority()) {
-    if (midi_io.writable()) {
-      midi_io.Overwrite(midi_dispatcher.ImmediateReadHighPriority());
-    }
+ISR(USART_UDRE_vect) {
+  // Clock messages come first, then the high priority buffer.
+  if (midi_dispatcher.clock_message_pending()) {
+    UDR0 = 0xf8;
+    midi_dispatcher.ClockMessageSent();
+  } else if (midi_dispatcher.readable_high_priority()) {
+    UDR0 = midi_dispatcher.ImmediateReadHighPriority();
+  } else if (midi_dispatcher.readable_low_priority()) {
+    UDR0 = midi_dispatcher.ImmediateReadLowPriority();
   } else {
-    if (midi_dispatcher.readable_low_priority()) {
-      if (midi_io.writable()) {
-        midi_io.Overwrite(midi_dispatcher.ImmediateReadLowPriority());
-      }
-    }
+    UCSR0B &= ~_BV(UDRIE0);
   }
 }
 
-inline void PollMidiIn() {
-  if (midi_io.readable()) {
-    midi_in_buffer.NonBlockingWrite(midi_io.ImmediateRead());
+// The default avrlib RX ISR is disabled (DISABLE_DEFAULT_UART_RX_ISR) so that
+// incoming bytes go straight to the MIDI input buffer, whatever the DAC timer
+// is doing.
+ISR(USART_RX_vect) {
+  uint8_t status = UCSR0A;
+  uint8_t rx_byte = UDR0;
+  if (status & (_BV(FE0) | _BV(DOR0))) {
+    diagnostics.Count(DIAGNOSTIC_COUNTER_MIDI_IN_ERROR);
+  }
+  if (!midi_in_buffer.NonBlockingWrite(rx_byte)) {
+    diagnostics.Count(DIAGNOSTIC_COUNTER_MIDI_IN_DROP);
+  } else if (rx_byte == 0xf8) {
+    clock.StampMidiClock();
+    latency_meter.Stamp(LATENCY_PATH_CLOCK_TO_TRIG);
+  } else {
+    latency_meter.StampMidiByte(rx_byte);
   }
 }
 
+// Saves to the EEPROM are written in the background, one byte per interrupt.
+ISR(EE_READY_vect) {
+  storage.WriteNextByte();
+}
+
 inline bool UpdateDACs() {
-  Word dac_value;
+  uint8_t readable = voice_controller.voice().readable();
+  if (!readable) {
+    diagnostics.Count(DIAGNOSTIC_COUNTER_DAC_UNDERRUN);
+  }
+  diagnostics.RecordLevel(DIAGNOSTIC_BUFFER_DAC, readable);
   voice_controller.mutable_voice()->ReadDACStateSample();
   const DACState& dac_state = voice_controller.voice().dac_state();
-  
-  // Write VCO CV.
-  // 0.5V / Oct.
-  // 2.048V = Midi note 60 = 261.625
-  dac_value.value = 0x1000 | dac_state.vco_cv;
-  dac_1_ss.Low();
-  dac.Send(dac_value.bytes[1]);
-  dac.Send(dac_value.bytes[0]);
-  dac_1_ss.High();
-  
-  // Write VCF CV.
-  // 0.5V / Oct.
-  dac_value.value = 0x9000 | dac_state.vcf_cv;
-  dac_1_ss.Low();
-  dac.Send(dac_value.bytes[1]);
-  dac.Send(dac_value.bytes[0]);
-  dac_1_ss.High();
-  
-  // Write VCA CV.
-  dac_value.value = 0x1000 | dac_state.vca_cv;
-  dac_2_ss.Low();
-  dac.Send(dac_value.bytes[1]);
-  dac.Send(dac_value.bytes[0]);
-  dac_2_ss.High();
-  
-  // Write PWM CV.
-  dac_value.value = 0x9000 | dac_state.pw_cv;
-  dac_2_ss.Low();
-  dac.Send(dac_value.bytes[1]);
-  dac.Send(dac_value.bytes[0]);
-  dac_2_ss.High();
-  
+  dac_controller.Write(dac_state);
   return dac_state.vca_cv != 0;
 }
 
 static uint8_t cycle = 0;
 static uint8_t previous_in = 0xff;
 
-// 4.9kHz: MIDI in/out; gate & clock poll.
+// 4.9kHz: gate & clock poll.
 // 2.45kHz: DAC & DCO refresh
 // 0.61kHz: UI poll
 ISR(TIMER0_OVF_vect, ISR_NOBLOCK) {
+  uint8_t start = profiler.dac_timer_value();
   if (cycle & 1) {
     if (UpdateDACs()) {
-      dco_controller.set_note(voice_controller.voice().dco_pitch());
+      dco_controller.set_period(voice_controller.voice().dac_state().dco_period);
     } else {
       // Mute the DCO when no note is playing to avoid signal bleed through the
       // drums channel.
       dco_controller.Mute();
     }
   }
-  PollMidiIn();
-  FlushMidiOut();
   
   // Read the input shift register without updating the switch debounce state.
+  // The last DAC word is still being shifted out meanwhile.
   uint8_t in = inputs.ReadRegister();
+  dac_controller.Finish();
   
   // Detect raising edges on the Trig line.
   if ((in & (1 << INPUT_TRIG)) && !(previous_in & (1 << INPUT_TRIG))) {
-    ++num_external_clock_events;
+    clock.Edge(clock.time(), false);
+    latency_meter.Stamp(LATENCY_PATH_CLOCK_TO_TRIG);
   }
   // Detect raising and falling edges on the Gate line.
   if ((in & (1 << INPUT_GATE)) && !(previous_in & (1 << INPUT_GATE))) {
@@ -170,7 +161,11 @@ ISR(TIMER0_OVF_vect, ISR_NOBLOCK) {
     ui.Poll();
   }
   outputs.Write(out);
+  latency_meter.ProcessOutputs(out);
   ++cycle;
+  profiler.Record(
+      PROFILER_STAGE_DAC_ISR,
+      U8U8Mul(profiler.dac_timer_value() - start, kDacTimerPrescaler));
 }
 
 // 2.5 MHz timebase used for oscillators calibration, and for DCO.
@@ -193,8 +188,29 @@ ISR(TIMER1_OVF_vect, ISR_NOBLOCK) {
 
 // 39kHz clock used for the tempo counter.
 ISR(TIMER2_OVF_vect, ISR_NOBLOCK) {
-  clock.Tick();
-  audio_out.Write(audio_buffer.ImmediateRead());
+  uint8_t start = profiler.audio_timer_value();
+  profiler.Tick();
+  if (clock.Tick()) {
+    // The trig out pulse and the MIDI clock message are sent right away, even
+    // if the main loop is late to run the sequencers.
+    voice_controller.StartClockPulse();
+    midi_dispatcher.OnClockPulse(clock.following_midi());
+  }
+  // Once the drums have faded out, the PWM output is left at its last value,
+  // 0, and the audio buffer is not read until they are woken up again.
+  if (!drum_synth.idle()) {
+    uint8_t readable = audio_buffer.readable();
+    if (readable) {
+      audio_out.Write(audio_buffer.ImmediateRead());
+    } else {
+      // Hold the previous sample rather than reading past the write pointer.
+      diagnostics.Count(DIAGNOSTIC_COUNTER_AUDIO_UNDERRUN);
+    }
+    diagnostics.RecordLevel(DIAGNOSTIC_BUFFER_AUDIO, readable);
+  }
+  profiler.Record(
+      PROFILER_STAGE_AUDIO_ISR,
+      (profiler.audio_timer_value() - start) * kAudioTimerPrescaler);
 }
 
 inline void Init() {
@@ -203,14 +219,13 @@ inline void Init() {
   ResetWatchdog();
   
   midi_io.Init();
+  UCSR0B |= _BV(RXCIE0);
   system_settings.Init();
   drum_synth.Init();
   voice_controller.Init();
   voice_tuner.Init();
   
-  dac.Init();
-  dac_1_ss.set_mode(DIGITAL_OUTPUT);
-  dac_2_ss.set_mode(DIGITAL_OUTPUT);
+  dac_controller.Init();
   dco_out.set_mode(DIGITAL_OUTPUT);
   
   pitch_calibration_input.set_mode(DIGITAL_INPUT);
@@ -235,61 +250,171 @@ inline void Init() {
   dco_controller.Start();
 }
 
-int main(void) {
-  Init();
-  ui.FlushEvents();
-  while (1) {
-    // Fill some samples for the DACs.
+// The main loop is a cooperative scheduler. The real-time tasks - which fill
+// the DAC state and audio buffers, and consume the clock ticks - run before
+// each task, and return immediately when there is nothing to do. The other
+// tasks report how urgently they need to run, from the fill level of the
+// buffer they drain, or from whether they have anything to do at all, and the
+// most urgent of them runs next. Tasks of equal urgency run in turn. A task
+// yields after a bounded amount of work, so that the buffers are refilled
+// between two chunks of a long MIDI burst.
+enum Task {
+  TASK_MIDI_PARSE,
+  TASK_SYSEX,
+  TASK_VOICE_TUNER,
+  TASK_UI,
+  TASK_LAST
+};
+
+enum TaskUrgency {
+  TASK_URGENCY_NONE,
+  TASK_URGENCY_NORMAL,
+  TASK_URGENCY_HIGH
+};
+
+// Number of MIDI bytes decoded before yielding.
+static const uint8_t kMidiParseChunkSize = 8;
+
+inline void RunRealTimeTasks() {
+  // Apply the latest values of the parameters changed by CCs, then fill
+  // some samples for the DACs.
+  if (voice_controller.voice().writable()) {
+    uint16_t start = profiler.ticks();
+    parameter_manager.FlushQueuedValues();
     voice_controller.mutable_voice()->Refresh();
-    
-    // Fill some samples for the PWM out. To avoid getting the 40kHz PWM carrier 
-    // when unnecessary, we set the output to 0 unless:
-    // - The drum machine is configured to play a pattern.
-    // - We have received a note message on MIDI channel 10, which is a hint
-    //   that an external sequencer might trigger Anushri's drum synth.
-    if (voice_controller.has_drums() ||
-        midi_dispatcher.seen_midi_drum_events() ||
-        drum_synth.playing()) {
+    profiler.RecordSince(PROFILER_STAGE_VOICE_REFRESH, start);
+  }
+  
+  // Fill some samples for the PWM out. To avoid getting the 40kHz PWM carrier 
+  // when unnecessary, we set the output to 0 unless:
+  // - The drum machine is configured to play a pattern.
+  // - We have received a note message on MIDI channel 10, which is a hint
+  //   that an external sequencer might trigger Anushri's drum synth.
+  if (voice_controller.has_drums() ||
+      midi_dispatcher.seen_midi_drum_events() ||
+      drum_synth.playing()) {
+    if (audio_buffer.writable() >= kAudioBlockSize) {
+      uint16_t start = profiler.ticks();
       drum_synth.Render();
-    } else {
-      drum_synth.FillWithSilence();
-    }
-    
-    // If we have not received any event on channel 10 for 5 mins, we consider
-    // that no further event will come and we preventively disable the drum
-    // engine.
-    if (drum_synth.idle_time_ms() > 300000) {
-      midi_dispatcher.ResetDrumEventMonitor();
+      profiler.RecordSince(PROFILER_STAGE_DRUM_RENDER, start);
     }
+  } else {
+    drum_synth.FillWithSilence();
+  }
+  
+  // If we have not received any event on channel 10 for 5 mins, we consider
+  // that no further event will come and we preventively disable the drum
+  // engine.
+  if (drum_synth.idle_time_ms() > 300000) {
+    midi_dispatcher.ResetDrumEventMonitor();
+  }
+  
+  // Complete the sequence slot switch requested, once the storage is idle.
+  voice_controller.RefreshSequence();
+  
+  // Count how many clock ticks have elapsed since the last refresh. When
+  // following an external or MIDI clock, the ticks are generated from the
+  // period and phase of the received edges.
+  clock.Refresh();
+  uint8_t num_events = clock.CountEvents();
+  while (num_events) {
+    voice_controller.Clock();
+    --num_events;
+  }
+}
 
-    // Count how many clock ticks have elapsed since the last refresh.
-    if (voice_controller.internal_clock()) {
-      uint8_t num_events = clock.CountEvents();
-      while (num_events) {
-        voice_controller.Clock(false);
-        --num_events;
+inline uint8_t GetTaskUrgency(uint8_t task) {
+  switch (task) {
+    case TASK_MIDI_PARSE:
+      {
+        // Past half of the input buffer, incoming data is at risk of being
+        // dropped.
+        uint8_t readable = midi_in_buffer.readable();
+        if (readable > MIDI_IN_BUFFER_SIZE / 2) {
+          return TASK_URGENCY_HIGH;
+        }
+        return readable ? TASK_URGENCY_NORMAL : TASK_URGENCY_NONE;
       }
-      num_external_clock_events = 0;
-    } else {
-      while (num_external_clock_events) {
-        voice_controller.Clock(false);
-        --num_external_clock_events;
+      
+    case TASK_SYSEX:
+      return sysex_handler.busy() ? TASK_URGENCY_NORMAL : TASK_URGENCY_NONE;
+      
+    case TASK_VOICE_TUNER:
+      return voice_tuner.running() ? TASK_URGENCY_NORMAL : TASK_URGENCY_NONE;
+      
+    case TASK_UI:
+      return ui.idle() ? TASK_URGENCY_NONE : TASK_URGENCY_NORMAL;
+      
+    default:
+      return TASK_URGENCY_NONE;
+  }
+}
+
+inline void RunTask(uint8_t task) {
+  switch (task) {
+    case TASK_MIDI_PARSE:
+      {
+        // Decode a chunk of the MIDI bytestream.
+        uint16_t start = profiler.ticks();
+        for (uint8_t n = kMidiParseChunkSize;
+             n && midi_in_buffer.readable(); --n) {
+          midi_parser.PushByte(midi_in_buffer.ImmediateRead());
+        }
+        profiler.RecordSince(PROFILER_STAGE_MIDI_PARSE, start);
       }
-    }
+      break;
+      
+    case TASK_SYSEX:
+      // Continue the SysEx dump in progress, if any.
+      sysex_handler.Refresh();
+      break;
+      
+    case TASK_VOICE_TUNER:
+      // Update the voice tuner state machine.
+      voice_tuner.Refresh();
+      if (num_overflows > 32) {
+        voice_tuner.Abort();
+      }
+      break;
+      
+    case TASK_UI:
+      {
+        // Handle UI events
+        uint16_t start = profiler.ticks();
+        ui.DoEvents();
+        profiler.RecordSince(PROFILER_STAGE_UI, start);
+      }
+      break;
+  }
+}
+
+int main(void) {
+  diagnostics.PaintStack();
+  Init();
+  ui.FlushEvents();
+  diagnostics.Reset();
+  profiler.Reset();
+  latency_meter.Reset();
+  uint8_t last_task = TASK_LAST - 1;
+  while (1) {
+    RunRealTimeTasks();
     
-    // Check if there is some MIDI data to process. If so, decode the MIDI
-    // bytestream.
-    while (midi_in_buffer.readable()) {
-      midi_parser.PushByte(midi_in_buffer.ImmediateRead());
+    // Pick the most urgent task, starting the search after the last one run
+    // so that tasks of equal urgency take turns.
+    uint8_t next_task = last_task;
+    uint8_t next_task_urgency = TASK_URGENCY_NONE;
+    uint8_t task = last_task;
+    for (uint8_t i = 0; i < TASK_LAST; ++i) {
+      task = task == TASK_LAST - 1 ? 0 : task + 1;
+      uint8_t urgency = GetTaskUrgency(task);
+      if (urgency > next_task_urgency) {
+        next_task = task;
+        next_task_urgency = urgency;
+      }
     }
-    
-    // Update the voice tuner state machine.
-    voice_tuner.Refresh();
-    if (num_overflows > 32) {
-      voice_tuner.Abort();
+    if (next_task_urgency != TASK_URGENCY_NONE) {
+      RunTask(next_task);
+      last_task = next_task;
     }
-    
-    // Handle UI events
-    ui.DoEvents();
   }
 }
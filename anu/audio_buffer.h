@@ -22,12 +22,19 @@
 
 #include "avrlib/ring_buffer.h"
 
+// Depth of the audio buffer, in samples. Must be a power of 2, 256 at most.
+// Each sample is 25.5us long, so the default size covers a 3.2ms stall of the
+// main loop.
+#ifndef AUDIO_BUFFER_SIZE
+#define AUDIO_BUFFER_SIZE 128
+#endif  // AUDIO_BUFFER_SIZE
+
 namespace anu {
 
 struct AudioBufferSpecs {
   typedef uint8_t Value;
   enum {
-    buffer_size = 128,
+    buffer_size = AUDIO_BUFFER_SIZE,
     data_size = 8,
   };
 };
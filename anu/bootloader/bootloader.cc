@@ -17,6 +17,17 @@
 //
 // Caveat: assumes the firmware flashing is always done from first to last
 // block, in increasing order. Random access flashing is not supported!
+//
+// Each valid block is copied to the SPM temporary page buffer as soon as it
+// has been received, and its page is then erased and written in the
+// background, while the next block is received in rx_buffer. Each block is
+// answered with a SysEx message f0 00 21 02 00 08 7d xx f7, where xx is 00 if
+// the block has been accepted, and 01 if it must be sent again. The host can
+// send the next block as soon as it has received the acknowledgment.
+//
+// Block data is nibble-encoded when the argument of the 0x7e command is 0x00,
+// and 7-bit packed when it is 0x01: groups of 7 bytes, each preceded by a byte
+// with their MSBs (MSB of the first byte in bit 0).
 
 #include <avr/boot.h>
 #include <avr/pgmspace.h>
@@ -33,7 +44,7 @@
 using namespace avrlib;
 using namespace anu;
 
-Serial<SerialPort0, 31250, POLLED, DISABLED> midi;
+Serial<SerialPort0, 31250, POLLED, POLLED> midi;
 
 Outputs outputs;
 ShiftRegisterInput<
@@ -44,7 +55,16 @@ ShiftRegisterInput<
     MSB_FIRST> inputs;
 
 uint16_t page = 0;
-uint8_t rx_buffer[2 * (SPM_PAGESIZE + 1)];
+uint8_t rx_buffer[SPM_PAGESIZE + 1];
+
+enum FlashState {
+  FLASH_IDLE,
+  FLASH_ERASING,
+  FLASH_WRITING
+};
+
+uint8_t flash_state = FLASH_IDLE;
+uint16_t flash_page;
 
 void (*main_entry_point)(void) = 0x0000;
 
@@ -54,23 +74,42 @@ inline void Init() {
   outputs.Init();
 }
 
+// Advances the erase/write sequence of the page being programmed.
+void ProgramFlash() {
+  if (flash_state == FLASH_IDLE || boot_spm_busy()) {
+    return;
+  }
+  if (flash_state == FLASH_ERASING) {
+    boot_page_write(flash_page);
+    flash_state = FLASH_WRITING;
+  } else {
+    boot_rww_enable();
+    flash_state = FLASH_IDLE;
+  }
+}
+
+void WaitForFlash() {
+  while (flash_state != FLASH_IDLE) {
+    ProgramFlash();
+  }
+}
+
 void WriteBufferToFlash() {
   uint16_t i;
   const uint8_t* p = rx_buffer;
+  WaitForFlash();
   eeprom_busy_wait();
 
-  boot_page_erase(page);
-  boot_spm_busy_wait();
-
+  // The temporary page buffer is filled before the page erase, which leaves
+  // it untouched. rx_buffer is thus immediately free for the next block.
   for (i = 0; i < SPM_PAGESIZE; i += 2) {
     uint16_t w = *p++;
     w |= (*p++) << 8;
     boot_page_fill(page + i, w);
   }
-
-  boot_page_write(page);
-  boot_spm_busy_wait();
-  boot_rww_enable();
+  flash_page = page;
+  boot_page_erase(flash_page);
+  flash_state = FLASH_ERASING;
 }
 
 static const uint8_t sysex_header[] = {
@@ -79,6 +118,25 @@ static const uint8_t sysex_header[] = {
   0x00, 0x08,  // Product ID for Anu.
 };
 
+uint8_t ack[] = {
+  0xf0, 0x00, 0x21, 0x02, 0x00, 0x08,
+  0x7d,  // Block acknowledgment.
+  0x00,  // Status: 0 = accepted, 1 = rejected.
+  0xf7
+};
+
+uint8_t ack_position = sizeof(ack);
+
+inline void SendAck(uint8_t status) {
+  ack[7] = status;
+  ack_position = 0;
+}
+
+// Page and checksum, in MIDI bytes.
+static const uint16_t kNibbleBlockSize = 2 * (SPM_PAGESIZE + 1);
+static const uint16_t kPackedBlockSize = (SPM_PAGESIZE + 1) + \
+    (SPM_PAGESIZE + 1 + 6) / 7;
+
 enum SysExReceptionState {
   MATCHING_HEADER = 0,
   READING_COMMAND = 1,
@@ -91,6 +149,8 @@ inline void MidiLoop() {
   uint16_t rx_buffer_index;
   uint8_t state = MATCHING_HEADER;
   uint8_t checksum;
+  uint8_t high_bits;
+  uint8_t group_mask;
   uint8_t sysex_commands[2];
   uint8_t current_led = 1;
   uint8_t status = 0;
@@ -100,7 +160,14 @@ inline void MidiLoop() {
   page = 0;
   outputs.Write(0x55 & 0x3f);
   while (1) {
-    byte = midi.Read();
+    ProgramFlash();
+    if (ack_position < sizeof(ack) && midi.writable()) {
+      midi.Overwrite(ack[ack_position++]);
+    }
+    if (!midi.readable()) {
+      continue;
+    }
+    byte = midi.ImmediateRead();
     // In case we see a realtime message in the stream, safely ignore it.
     if (byte > 0xf0 && byte != 0xf7) {
       continue;
@@ -126,6 +193,7 @@ inline void MidiLoop() {
             bytes_read = 0;
             rx_buffer_index = 0;
             checksum = 0;
+            group_mask = sysex_commands[1] == 0x01 ? 7 : 1;
             state = READING_DATA;
           }
         } else {
@@ -138,14 +206,24 @@ inline void MidiLoop() {
 
       case READING_DATA:
         if (byte < 0x80) {
-          if (bytes_read & 1) {
-            rx_buffer[rx_buffer_index] |= byte & 0xf;
-            if (rx_buffer_index < SPM_PAGESIZE) {
-              checksum += rx_buffer[rx_buffer_index];
-            }
-            ++rx_buffer_index;
+          if ((bytes_read & group_mask) == 0) {
+            high_bits = byte;
           } else {
-            rx_buffer[rx_buffer_index] = (byte << 4);
+            uint8_t value;
+            if (group_mask == 1) {
+              value = (high_bits << 4) | (byte & 0xf);
+            } else {
+              value = byte | (high_bits << 7);
+              high_bits >>= 1;
+            }
+            // Oversized blocks are not stored, and rejected at the end.
+            if (rx_buffer_index <= SPM_PAGESIZE) {
+              rx_buffer[rx_buffer_index] = value;
+              if (rx_buffer_index < SPM_PAGESIZE) {
+                checksum += value;
+              }
+              ++rx_buffer_index;
+            }
           }
           ++bytes_read;
         } else if (byte == 0xf7) {
@@ -153,13 +231,16 @@ inline void MidiLoop() {
               sysex_commands[1] == 0x00 &&
               bytes_read == 0) {
             // Reset.
+            WaitForFlash();
             return;
-          } else if (rx_buffer_index == SPM_PAGESIZE + 1 &&
-                     sysex_commands[0] == 0x7e &&
-                     sysex_commands[1] == 0x00 &&
+          } else if (sysex_commands[0] == 0x7e &&
+                     bytes_read == (group_mask == 1 ?
+                         kNibbleBlockSize : kPackedBlockSize) &&
+                     sysex_commands[1] <= 0x01 &&
                      rx_buffer[rx_buffer_index - 1] == checksum) {
             // Block write.
             WriteBufferToFlash();
+            SendAck(0);
             page += SPM_PAGESIZE;
             ++progress_counter;
             if (progress_counter == 32) {
@@ -173,6 +254,9 @@ inline void MidiLoop() {
             }
             status ^= current_led;
           } else {
+            if (sysex_commands[0] == 0x7e) {
+              SendAck(1);
+            }
             current_led = 1;
             status = 0;
           }
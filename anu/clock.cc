@@ -32,6 +32,34 @@ uint8_t Clock::prescaler_;
 uint8_t Clock::prescaler_counter_ = 0;
 uint16_t Clock::tick_duration_ = 0;
 volatile uint8_t Clock::num_clock_events_ = 0;
+
+uint8_t Clock::groove_template_;
+uint8_t Clock::groove_amount_;
+uint16_t Clock::base_tick_duration_;
+uint8_t Clock::groove_lag_;
+uint8_t Clock::groove_lead_;
+
+volatile uint16_t Clock::time_;
+bool Clock::following_;
+bool Clock::midi_;
+bool Clock::new_edge_;
+bool Clock::previous_edge_valid_;
+uint16_t Clock::previous_edge_time_;
+uint32_t Clock::period_;
+uint8_t Clock::edge_tick_;
+int8_t Clock::edge_credit_;
+uint16_t Clock::edge_counter_;
+uint16_t Clock::edge_duration_;
+uint16_t Clock::edge_delay_;
+volatile uint8_t Clock::edge_ticks_;
+volatile uint8_t Clock::emitted_ticks_;
+volatile int8_t Clock::catch_up_threshold_;
+volatile int8_t Clock::hold_threshold_;
+
+volatile uint16_t Clock::midi_clock_stamps_[kNumMidiClockStamps];
+volatile uint8_t Clock::midi_clock_stamps_write_ptr_;
+volatile uint8_t Clock::midi_clock_stamps_read_ptr_;
+volatile uint8_t Clock::midi_clock_stamps_valid_;
 /* </static> */
 
 static const uint32_t kSampleRateNum = 2000000L;
@@ -39,6 +67,81 @@ static const uint32_t kSampleRateDen = 51L;
 static const int32_t kTempoFactor = \
     (4 * kSampleRateNum * 60L / 24L / kSampleRateDen);
 
+// Number of ticks that can be generated ahead of the edge they belong to, on
+// top of those the groove template moves ahead.
+static const int8_t kMaxLead = 1;
+
+// Longest interval between two edges (0.77s), beyond which the clock is
+// considered as stopped, and the next edge restarts the period measurement.
+static const uint16_t kMaxPeriod = 30000;
+
+/* static */
+void Clock::ComputeTickDurations(uint16_t base_tick_duration) {
+  // Also keep track of how far behind or ahead of a straight clock the
+  // groove template can get.
+  int32_t offset = 0;
+  int32_t max_offset = 0;
+  int32_t min_offset = 0;
+  for (uint8_t i = 0; i < kNumStepsInGroovePattern; ++i) {
+    int32_t swing_direction = static_cast<int16_t>(pgm_read_word(
+        lookup_table_table[LUT_RES_GROOVE_SWING + groove_template_] + i));
+    swing_direction *= base_tick_duration;
+    swing_direction *= groove_amount_;
+    int16_t swing = swing_direction >> 16;
+    // The table is read by Tick() at each step.
+    uint8_t sreg = SREG;
+    cli();
+    tick_duration_table_[i] = base_tick_duration + swing;
+    SREG = sreg;
+    offset += swing * kNumTicksPerStep;
+    if (offset > max_offset) {
+      max_offset = offset;
+    } else if (offset < min_offset) {
+      min_offset = offset;
+    }
+  }
+  base_tick_duration_ = base_tick_duration;
+  groove_lag_ = (max_offset + base_tick_duration - 1) / base_tick_duration;
+  groove_lead_ = (base_tick_duration - 1 - min_offset) / base_tick_duration;
+}
+
+/* static */
+uint16_t Clock::TickDuration(uint8_t step, uint8_t tick_count, int8_t ticks) {
+  // Duration of the interval ending with the tick which comes the given number
+  // of ticks after the next tick to be emitted, at position step/tick_count.
+  int8_t tick = tick_count + ticks;
+  while (tick < 0) {
+    tick += kNumTicksPerStep;
+    --step;
+  }
+  while (tick >= kNumTicksPerStep) {
+    tick -= kNumTicksPerStep;
+    ++step;
+  }
+  return tick_duration_table_[step & (kNumStepsInGroovePattern - 1)];
+}
+
+/* static */
+int32_t Clock::GrooveOffset(uint8_t step, uint8_t tick, int8_t ticks) {
+  // Delay caused by the groove template, relative to a straight clock, of the
+  // tick which comes the given number of ticks after the next tick to be
+  // emitted.
+  int32_t offset = 0;
+  for (uint8_t i = 0; i < step; ++i) {
+    offset += tick_duration_table_[i] - base_tick_duration_;
+  }
+  offset *= kNumTicksPerStep;
+  offset += static_cast<int32_t>(tick) * \
+      (tick_duration_table_[step] - base_tick_duration_);
+  for (int8_t i = 0; i < ticks; ++i) {
+    offset += TickDuration(step, tick, i) - base_tick_duration_;
+  }
+  for (int8_t i = ticks; i < 0; ++i) {
+    offset -= TickDuration(step, tick, i) - base_tick_duration_;
+  }
+  return offset + TickDuration(step, tick, ticks) - base_tick_duration_;
+}
+
 /* static */
 void Clock::Update(
     uint8_t bpm,
@@ -47,19 +150,138 @@ void Clock::Update(
     uint8_t prescaler) {
   STATIC_ASSERT(kTempoFactor == 392156L);
 
+  groove_template_ = groove_template;
+  groove_amount_ = groove_amount;
+  prescaler_ = prescaler;
+  if (bpm == 0) {
+    // The tick durations are computed by Refresh() after the next edge.
+    if (!following_) {
+      uint8_t sreg = SREG;
+      cli();
+      previous_edge_valid_ = false;
+      period_ = 0;
+      emitted_ticks_ = edge_ticks_;
+      catch_up_threshold_ = 0;
+      hold_threshold_ = 0;
+      following_ = true;
+      SREG = sreg;
+    }
+    return;
+  }
+  following_ = false;
+  
   int32_t rounding = 2 * static_cast<int32_t>(bpm);
   int32_t denominator = 4 * static_cast<int32_t>(bpm);
   int16_t base_tick_duration = (kTempoFactor + rounding) / denominator;
-  for (uint8_t i = 0; i < kNumStepsInGroovePattern; ++i) {
-    int32_t swing_direction = static_cast<int16_t>(pgm_read_word(
-        lookup_table_table[LUT_RES_GROOVE_SWING + groove_template] + i));
-    swing_direction *= base_tick_duration;
-    swing_direction *= groove_amount;
-    int16_t swing = swing_direction >> 16;
-    tick_duration_table_[i] = base_tick_duration + swing;
+  ComputeTickDurations(base_tick_duration);
+  uint8_t sreg = SREG;
+  cli();
+  tick_duration_ = tick_duration_table_[step_count_];
+  SREG = sreg;
+}
+
+/* static */
+void Clock::Edge(uint16_t time, bool midi) {
+  if (!following_) {
+    return;
   }
-  tick_duration_ = tick_duration_table_[0];
-  prescaler_ = prescaler;
+  uint8_t sreg = SREG;
+  cli();
+  uint16_t interval = time - previous_edge_time_;
+  if (previous_edge_valid_ && interval <= kMaxPeriod) {
+    int32_t period_error = (static_cast<int32_t>(interval) << 8) - period_;
+    int32_t tolerance = period_ >> 2;
+    if (!period_ || period_error > tolerance || period_error < -tolerance) {
+      // Jump to the new tempo.
+      period_ = static_cast<uint32_t>(interval) << 8;
+    } else {
+      period_ += period_error >> 2;
+    }
+  }
+  previous_edge_time_ = time;
+  previous_edge_valid_ = true;
+  
+  // The phase error is computed by Refresh() from the state of the generator
+  // at this time.
+  edge_credit_ = edge_ticks_ - emitted_ticks_;
+  edge_counter_ = clock_counter_;
+  edge_duration_ = tick_duration_;
+  edge_delay_ = time_ - time;
+  edge_tick_ = edge_ticks_;
+  edge_ticks_ += prescaler_;
+  midi_ = midi;
+  new_edge_ = true;
+  SREG = sreg;
+}
+
+/* static */
+void Clock::Refresh() {
+  if (!following_) {
+    return;
+  }
+  uint8_t sreg = SREG;
+  cli();
+  bool new_edge = new_edge_;
+  new_edge_ = false;
+  uint32_t period_fractional = period_;
+  uint16_t period = period_fractional >> 8;
+  int8_t ticks_since_edge = emitted_ticks_ - edge_tick_;
+  uint8_t step = step_count_;
+  uint8_t tick = tick_count_;
+  int8_t credit = edge_credit_;
+  uint16_t counter = edge_counter_;
+  uint16_t duration = edge_duration_;
+  int32_t tick_delay = edge_delay_;
+  tick_delay -= counter;
+  if (period && static_cast<uint16_t>(time_ - previous_edge_time_) > \
+      2 * period) {
+    // The clock has stopped. Do not generate ticks ahead of the next edge,
+    // and generate its ticks as soon as it is received.
+    period_ = period = 0;
+    previous_edge_valid_ = false;
+    catch_up_threshold_ = 0;
+    hold_threshold_ = 0;
+  }
+  SREG = sreg;
+  
+  if (!new_edge || !period) {
+    return;
+  }
+  
+  // Time between this edge and the tick due at this edge, which is the first
+  // of the ticks it gives credit for. When the generator is in phase, this is
+  // the delay given by the groove template.
+  int8_t next_tick = -ticks_since_edge - credit;
+  if (credit >= 0) {
+    tick_delay += duration;
+    for (int8_t i = 1; i <= credit; ++i) {
+      tick_delay += TickDuration(step, tick, next_tick + i);
+    }
+  } else {
+    for (int8_t i = next_tick - 1; i > -ticks_since_edge; --i) {
+      tick_delay -= TickDuration(step, tick, i);
+    }
+  }
+  
+  // Correct a quarter of the phase error over the next edge. The error is
+  // positive when the generator is ahead.
+  int32_t error = GrooveOffset(step, tick, -ticks_since_edge) - tick_delay;
+  uint16_t base_tick_duration = (period_fractional / prescaler_ + 128) >> 8;
+  error /= 4 * prescaler_;
+  int32_t tick_duration = base_tick_duration + error;
+  if (tick_duration < (base_tick_duration >> 1)) {
+    tick_duration = base_tick_duration >> 1;
+  } else if (tick_duration > (base_tick_duration << 1)) {
+    tick_duration = base_tick_duration << 1;
+  }
+  ComputeTickDurations(tick_duration);
+  
+  sreg = SREG;
+  cli();
+  tick_duration_ = tick_duration_table_[step_count_];
+  catch_up_threshold_ = prescaler_ + 1 + groove_lag_;
+  hold_threshold_ = -kMaxLead - groove_lead_;
+  SREG = sreg;
 }
 
 /* extern */
@@ -16,10 +16,25 @@
 // -----------------------------------------------------------------------------
 //
 // Global clock.
+//
+// When following an external or MIDI clock, the ticks are not triggered by the
+// clock edges. Instead, each edge is timestamped and gives credit for
+// prescaler_ ticks. The ticks are generated at the period measured between
+// edges, with the groove template applied, and a phase corrector keeps them
+// aligned with the edges. A tick can be generated before the edge it belongs
+// to (kMaxLead), so that the output does not inherit the jitter of the input.
+//
+// Tick() runs in the 39kHz audio ISR, where it also advances the position in
+// the groove template. Each tick deadline is thus known as soon as the
+// previous tick has been emitted, and the outputs which need accurate timing
+// (trig out, MIDI clock) are generated from the ISR. Only the sequencers wait
+// for the main loop.
 
 #ifndef ANU_CLOCK_H_
 #define ANU_CLOCK_H_
 
+#include <avr/interrupt.h>
+
 #include "avrlib/base.h"
 #include "avrlib/gpio.h"
 
@@ -27,44 +42,100 @@ namespace anu {
 
 static const uint8_t kNumStepsInGroovePattern = 16;
 static const uint8_t kNumTicksPerStep = 6;
+static const uint8_t kNumMidiClockStamps = 4;  // At most 8.
 
 class Clock {
  public:
   static inline void Reset() {
+    uint8_t sreg = SREG;
+    cli();
     clock_counter_ = 0;
     tick_count_ = 0;
     step_count_ = 0;
     tick_duration_ = tick_duration_table_[0];
     num_clock_events_ = 0;
+    SREG = sreg;
   }
   
-  static inline void Tick() {
+  // Returns true when a clock pulse (a tick, after the prescaler) is due.
+  static inline bool Tick() {
+    // time_ is read by the MIDI input ISR, which can interrupt this one.
+    cli();
+    ++time_;
+    sei();
     ++clock_counter_;
-    if (clock_counter_ >= tick_duration_) {
-      ++num_clock_events_;
-      clock_counter_ = 0;
+    if (following_) {
+      int8_t credit = edge_ticks_ - emitted_ticks_;
+      if (credit > catch_up_threshold_ ||
+          (clock_counter_ >= tick_duration_ && credit > hold_threshold_)) {
+        ++emitted_ticks_;
+        return EmitTick();
+      } else if (clock_counter_ > tick_duration_) {
+        // Wait for the next edge.
+        clock_counter_ = tick_duration_;
+      }
+    } else if (clock_counter_ >= tick_duration_) {
+      return EmitTick();
     }
+    return false;
   }
   
-  static inline uint8_t CountEvents() {
-    uint8_t count = 0;
-    while (num_clock_events_) {
-      ++tick_count_;
-      if (tick_count_ == kNumTicksPerStep) {
-        tick_count_ = 0;
-        ++step_count_;
-        if (step_count_ == kNumStepsInGroovePattern) {
-          step_count_ = 0;
-        }
-        tick_duration_ = tick_duration_table_[step_count_];
-      }
-      ++prescaler_counter_;
-      if (prescaler_counter_ >= prescaler_) {
-        ++count;
-        prescaler_counter_ = 0;
-      }
-      --num_clock_events_;
+  // Records the arrival time of a MIDI clock message. Called from the MIDI
+  // input ISR, the stamps are then read, in order, when the messages are
+  // parsed. The pointers count the messages, and a message which arrives while
+  // all the stamps are waiting to be read is not stamped: it still gives credit
+  // for its ticks (Credit()), but is not used to measure the period.
+  static inline void StampMidiClock() {
+    uint8_t slot = midi_clock_stamps_write_ptr_ & (kNumMidiClockStamps - 1);
+    if (static_cast<uint8_t>(
+            midi_clock_stamps_write_ptr_ - midi_clock_stamps_read_ptr_) < \
+        kNumMidiClockStamps) {
+      midi_clock_stamps_[slot] = time_;
+      midi_clock_stamps_valid_ |= 1 << slot;
     }
+    ++midi_clock_stamps_write_ptr_;
+  }
+  
+  // Returns false if the message was not stamped.
+  static inline bool ReadMidiClockStamp(uint16_t* stamp) {
+    uint8_t sreg = SREG;
+    cli();
+    uint8_t slot = midi_clock_stamps_read_ptr_ & (kNumMidiClockStamps - 1);
+    uint8_t mask = 1 << slot;
+    bool valid = midi_clock_stamps_valid_ & mask;
+    midi_clock_stamps_valid_ &= ~mask;
+    *stamp = midi_clock_stamps_[slot];
+    ++midi_clock_stamps_read_ptr_;
+    SREG = sreg;
+    return valid;
+  }
+  
+  // Clock edge, received at the given time. Ignored when not following.
+  static void Edge(uint16_t time, bool midi);
+  
+  // Clock edge of unknown arrival time. Gives credit for its ticks, and
+  // restarts the period measurement from the next edge.
+  static inline void Credit() {
+    if (!following_) {
+      return;
+    }
+    uint8_t sreg = SREG;
+    cli();
+    previous_edge_valid_ = false;
+    edge_ticks_ += prescaler_;
+    SREG = sreg;
+  }
+  
+  // Updates the tick durations after each edge, when following.
+  static void Refresh();
+  
+  // Returns the number of clock pulses elapsed since the last call.
+  static inline uint8_t CountEvents() {
+    uint8_t sreg = SREG;
+    cli();
+    uint8_t count = num_clock_events_;
+    num_clock_events_ = 0;
+    SREG = sreg;
     return count;
   }
   
@@ -72,6 +143,18 @@ class Clock {
     prescaler_ = prescaler;
   }
   
+  static inline uint16_t time() {
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t t = time_;
+    SREG = sreg;
+    return t;
+  }
+  
+  // Whether the ticks are generated from MIDI clock messages.
+  static inline bool following_midi() { return following_ && midi_; }
+  
+  // A bpm of 0 follows the external or MIDI clock.
   static void Update(
       uint8_t bpm,
       uint8_t groove_template,
@@ -79,6 +162,30 @@ class Clock {
       uint8_t prescaler);
 
  private:
+  static inline bool EmitTick() {
+    clock_counter_ = 0;
+    ++tick_count_;
+    if (tick_count_ == kNumTicksPerStep) {
+      tick_count_ = 0;
+      ++step_count_;
+      if (step_count_ == kNumStepsInGroovePattern) {
+        step_count_ = 0;
+      }
+      tick_duration_ = tick_duration_table_[step_count_];
+    }
+    ++prescaler_counter_;
+    if (prescaler_counter_ >= prescaler_) {
+      prescaler_counter_ = 0;
+      ++num_clock_events_;
+      return true;
+    }
+    return false;
+  }
+  
+  static void ComputeTickDurations(uint16_t base_tick_duration);
+  static uint16_t TickDuration(uint8_t step, uint8_t tick, int8_t ticks);
+  static int32_t GrooveOffset(uint8_t step, uint8_t tick, int8_t ticks);
+  
   static uint16_t clock_counter_;
   static uint16_t tick_duration_table_[kNumStepsInGroovePattern];
   static uint16_t tick_duration_;
@@ -87,6 +194,34 @@ class Clock {
   static uint8_t prescaler_;
   static uint8_t prescaler_counter_;
   static volatile uint8_t num_clock_events_;
+  
+  static uint8_t groove_template_;
+  static uint8_t groove_amount_;
+  static uint16_t base_tick_duration_;
+  static uint8_t groove_lag_;
+  static uint8_t groove_lead_;
+  
+  static volatile uint16_t time_;
+  static bool following_;
+  static bool midi_;
+  static bool new_edge_;
+  static bool previous_edge_valid_;
+  static uint16_t previous_edge_time_;
+  static uint32_t period_;
+  static uint8_t edge_tick_;
+  static int8_t edge_credit_;
+  static uint16_t edge_counter_;
+  static uint16_t edge_duration_;
+  static uint16_t edge_delay_;
+  static volatile uint8_t edge_ticks_;
+  static volatile uint8_t emitted_ticks_;
+  static volatile int8_t catch_up_threshold_;
+  static volatile int8_t hold_threshold_;
+  
+  static volatile uint16_t midi_clock_stamps_[kNumMidiClockStamps];
+  static volatile uint8_t midi_clock_stamps_write_ptr_;
+  static volatile uint8_t midi_clock_stamps_read_ptr_;
+  static volatile uint8_t midi_clock_stamps_valid_;
 };
 
 extern Clock clock;
@@ -0,0 +1,42 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "anu/dac_controller.h"
+
+namespace anu {
+
+/* static */
+uint16_t DacController::value_[DAC_CHANNEL_LAST];
+
+/* static */
+bool DacController::busy_;
+
+/* static */
+void DacController::Init() {
+  DACInterface::Init();
+  DAC1SS::set_mode(DIGITAL_OUTPUT);
+  DAC2SS::set_mode(DIGITAL_OUTPUT);
+  DAC1SS::High();
+  DAC2SS::High();
+  busy_ = false;
+  for (uint8_t i = 0; i < DAC_CHANNEL_LAST; ++i) {
+    value_[i] = kUnknownDacValue;
+  }
+}
+
+/* extern */
+DacController dac_controller;
+
+}  // namespace anu
@@ -0,0 +1,119 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+//
+// -----------------------------------------------------------------------------
+//
+// Driver for the two MCP4822 DACs generating the VCO/VCF and VCA/PW CVs.
+//
+// Only the channels whose value has changed since the last update are sent,
+// which means no SPI traffic at all during the sustain phase of a note. The
+// transfers are pipelined with the CPU: the next word is prepared while the
+// previous byte is shifted out, and the last byte of an update is left in
+// flight while the DAC ISR does its other work - Finish() must be called
+// before the end of the ISR to latch it. At a SPI clock of F_CPU / 2, a byte
+// takes 16 cycles, less than entering and leaving a SPI transfer complete
+// interrupt, so the SPIF flag is polled rather than used as an interrupt
+// source.
+
+#ifndef ANU_DAC_CONTROLLER_H_
+#define ANU_DAC_CONTROLLER_H_
+
+#include <avr/io.h>
+
+#include "avrlib/base.h"
+
+#include "anu/hardware_config.h"
+#include "anu/voice.h"
+
+namespace anu {
+
+enum DacChannel {
+  DAC_CHANNEL_VCO,
+  DAC_CHANNEL_VCF,
+  DAC_CHANNEL_VCA,
+  DAC_CHANNEL_PW,
+  DAC_CHANNEL_LAST
+};
+
+// Not a valid 12-bit DAC code, forces a channel to be written.
+static const uint16_t kUnknownDacValue = 0xffff;
+
+class DacController {
+ public:
+  DacController() { }
+  ~DacController() { }
+  
+  static void Init();
+  
+  // Sends the channels of "state" that have changed, and returns without
+  // waiting for the completion of the last byte.
+  static inline void Write(const DACState& state) {
+    // 0.5V / Oct.
+    // 2.048V = Midi note 60 = 261.625
+    WriteChannel<DAC1SS>(DAC_CHANNEL_VCO, 0x1000, state.vco_cv);
+    // 0.5V / Oct.
+    WriteChannel<DAC1SS>(DAC_CHANNEL_VCF, 0x9000, state.vcf_cv);
+    WriteChannel<DAC2SS>(DAC_CHANNEL_VCA, 0x1000, state.vca_cv);
+    WriteChannel<DAC2SS>(DAC_CHANNEL_PW, 0x9000, state.pw_cv);
+  }
+  
+  // Waits for the last byte sent by Write, and latches it.
+  static inline void Finish() {
+    if (busy_) {
+      Wait();
+      DAC1SS::High();
+      DAC2SS::High();
+      busy_ = false;
+    }
+  }
+  
+ private:
+  static inline void Wait() {
+    while (!(SPSR & _BV(SPIF)));
+  }
+  
+  template<typename SlaveSelect>
+  static inline void WriteChannel(
+      DacChannel channel,
+      uint16_t command,
+      uint16_t value) {
+    if (value == value_[channel]) {
+      return;
+    }
+    value_[channel] = value;
+    Word word;
+    word.value = command | value;
+    // Complete the transfer of the previous channel, if any. Raising the
+    // slave select line latches the value in the DAC.
+    Finish();
+    SlaveSelect::Low();
+    SPDR = word.bytes[1];
+    busy_ = true;
+    Wait();
+    SPDR = word.bytes[0];
+  }
+  
+  static uint16_t value_[DAC_CHANNEL_LAST];
+  static bool busy_;
+  
+  DISALLOW_COPY_AND_ASSIGN(DacController);
+};
+
+extern DacController dac_controller;
+
+}  // namespace anu
+
+#endif  // ANU_DAC_CONTROLLER_H_
@@ -20,6 +20,9 @@
 
 namespace anu {
 
+/* static */
+uint16_t DcoController::period_ = kUnknownPeriod;
+
 /* extern */
 DcoController dco_controller;
 
@@ -20,14 +20,13 @@
 #include "avrlib/op.h"
 
 #include "anu/hardware_config.h"
-#include "anu/resources.h"
 
 namespace anu {
 
 using namespace avrlib;
 
-static const uint16_t kOctave = 12 << 7;
-static const uint16_t kFirstNote = 16 << 7;
+// Longer than the period of the lowest note.
+static const uint16_t kUnknownPeriod = 0xffff;
 
 class DcoController {
  public:
@@ -35,6 +34,7 @@ class DcoController {
   ~DcoController() { }
   
   static void Start() {
+    period_ = kUnknownPeriod;
     // Configure the 16-bit timer for the "PWM, Phase and Frequency Correct"
     // mode, TOP set by OCR1A.
     TuningTimer::set_mode(_BV(WGM10), _BV(WGM13), 2);
@@ -47,33 +47,22 @@ class DcoController {
   }
   
   static void Mute() {
-    Dco::set_frequency(0);
+    set_period(0);
   }
   
-  static void set_note(int16_t note) {
-    // Lowest note: E0.
-    note -= kFirstNote;
-    // Transpose the lowest octave up.
-    while (note < 0) {
-      note += kOctave;
+  // The period is computed by the voice, along with the CV values, so this is
+  // cheap enough to be called from the DAC ISR. The timer register is written
+  // only when the period changes.
+  static inline void set_period(uint16_t period) {
+    if (period != period_) {
+      period_ = period;
+      Dco::set_frequency(period);
     }
-    uint8_t shifts = 0;
-    while (note >= kOctave) {
-      note -= kOctave;
-      ++shifts;
-    }
-    uint16_t index_integral = U16ShiftRight4(note);
-    uint16_t index_fractional = U8U8Mul(note & 0xf, 16);
-    uint16_t count = pgm_read_word(lut_res_dco_pitch + index_integral);
-    uint16_t next = pgm_read_word(lut_res_dco_pitch + index_integral + 1);
-    count -= U16U8MulShift8(count - next, index_fractional);
-    while (shifts--) {
-      count >>= 1;
-    }
-    Dco::set_frequency(count);
   }
   
  private:
+  static uint16_t period_;
+  
   DISALLOW_COPY_AND_ASSIGN(DcoController);
 };
 
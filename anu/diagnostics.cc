@@ -0,0 +1,87 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Glitch counters and buffer monitor.
+
+#include "anu/diagnostics.h"
+
+#include <avr/interrupt.h>
+#include <string.h>
+
+#include "anu/audio_buffer.h"
+#include "anu/voice.h"
+
+extern uint8_t __data_start;
+extern uint8_t _end;
+
+namespace anu {
+
+static const uint8_t kStackCanary = 0xc5;
+
+/* <static> */
+uint16_t Diagnostics::counters_[DIAGNOSTIC_COUNTER_LAST];
+uint8_t Diagnostics::low_water_mark_[DIAGNOSTIC_BUFFER_LAST];
+/* </static> */
+
+/* static */
+void Diagnostics::Reset() {
+  uint8_t sreg = SREG;
+  cli();
+  memset(counters_, 0, sizeof(counters_));
+  memset(low_water_mark_, 0xff, sizeof(low_water_mark_));
+  SREG = sreg;
+}
+
+/* static */
+void Diagnostics::Report(DiagnosticReport* report) {
+  report->buffer_size[DIAGNOSTIC_BUFFER_AUDIO] = AUDIO_BUFFER_SIZE - 1;
+  report->buffer_size[DIAGNOSTIC_BUFFER_DAC] = kDACStateBufferSize - 1;
+  uint8_t sreg = SREG;
+  cli();
+  memcpy(report->counter, counters_, sizeof(counters_));
+  memcpy(report->buffer_low_water_mark, low_water_mark_,
+         sizeof(low_water_mark_));
+  SREG = sreg;
+  Reset();
+}
+
+/* static */
+void Diagnostics::PaintStack() {
+  // Everything below the stack pointer is free.
+  uint8_t* p = &_end;
+  uint8_t* stack_pointer = reinterpret_cast<uint8_t*>(SP);
+  while (p < stack_pointer) {
+    *p++ = kStackCanary;
+  }
+}
+
+/* static */
+void Diagnostics::ReportMemory(MemoryReport* report) {
+  uint8_t* p = &_end;
+  uint8_t* ram_end = reinterpret_cast<uint8_t*>(RAMEND);
+  while (p <= ram_end && *p == kStackCanary) {
+    ++p;
+  }
+  report->static_ram = &_end - &__data_start;
+  report->stack_high_water_mark = ram_end + 1 - p;
+  report->never_used = p - &_end;
+}
+
+/* extern */
+Diagnostics diagnostics;
+
+}  // namespace anu
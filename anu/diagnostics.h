@@ -0,0 +1,98 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Always-on counters of the events which are likely to cause audible
+// glitches (buffer underruns, dropped bytes...) and fill level low-water
+// marks of the buffers shared between the ISRs and the main loop. All
+// updates are single byte or saturating 16-bit increments, cheap enough to be
+// done in the ISRs.
+//
+// The RAM between the end of the static data and the stack is painted at boot,
+// and the deepest stack excursion since then - ISRs included - is found by
+// looking for the first byte which has been overwritten.
+
+#ifndef ANU_DIAGNOSTICS_H_
+#define ANU_DIAGNOSTICS_H_
+
+#include "avrlib/base.h"
+
+namespace anu {
+
+enum DiagnosticCounter {
+  DIAGNOSTIC_COUNTER_AUDIO_UNDERRUN,
+  DIAGNOSTIC_COUNTER_DAC_UNDERRUN,
+  DIAGNOSTIC_COUNTER_MIDI_IN_ERROR,  // UART framing error or data overrun.
+  DIAGNOSTIC_COUNTER_MIDI_IN_DROP,  // MIDI input buffer full.
+  DIAGNOSTIC_COUNTER_POT_COALESCED,  // Pot value replaced before handled.
+  DIAGNOSTIC_COUNTER_LAST
+};
+
+enum DiagnosticBuffer {
+  DIAGNOSTIC_BUFFER_AUDIO,
+  DIAGNOSTIC_BUFFER_DAC,
+  DIAGNOSTIC_BUFFER_LAST
+};
+
+struct DiagnosticReport {
+  uint16_t counter[DIAGNOSTIC_COUNTER_LAST];
+  uint8_t buffer_size[DIAGNOSTIC_BUFFER_LAST];
+  uint8_t buffer_low_water_mark[DIAGNOSTIC_BUFFER_LAST];
+};
+
+struct MemoryReport {
+  uint16_t static_ram;  // .data and .bss.
+  uint16_t stack_high_water_mark;
+  uint16_t never_used;  // Painted bytes never reached by the stack.
+};
+
+class Diagnostics {
+ public:
+  Diagnostics() { }
+  
+  static inline void Count(uint8_t counter) {
+    if (counters_[counter] != 0xffff) {
+      ++counters_[counter];
+    }
+  }
+  
+  static inline void RecordLevel(uint8_t buffer, uint8_t level) {
+    if (level < low_water_mark_[buffer]) {
+      low_water_mark_[buffer] = level;
+    }
+  }
+  
+  static void Reset();
+  
+  // Must be called at boot, before enabling interrupts.
+  static void PaintStack();
+  static void ReportMemory(MemoryReport* report);
+  
+  // Each report covers the interval since the previous one.
+  static void Report(DiagnosticReport* report);
+  
+ private:
+  static uint16_t counters_[DIAGNOSTIC_COUNTER_LAST];
+  static uint8_t low_water_mark_[DIAGNOSTIC_BUFFER_LAST];
+  
+  DISALLOW_COPY_AND_ASSIGN(Diagnostics);
+};
+
+extern Diagnostics diagnostics;
+
+}  // namespace anu
+
+#endif  // ANU_DIAGNOSTICS_H_
@@ -33,6 +33,9 @@ DrumSynth drum_synth;
 /* static */
 DrumPatch DrumSynth::patch_[kNumDrumInstruments];
 
+/* static */
+DrumTriggerState DrumSynth::trigger_state_[kNumDrumInstruments];
+
 /* static */
 DrumState DrumSynth::state_[kNumDrumInstruments];
 
@@ -51,9 +54,33 @@ uint8_t DrumSynth::fade_counter_;
 /* static */
 bool DrumSynth::playing_;
 
+/* static */
+bool DrumSynth::idle_;
+
+/* static */
+uint16_t DrumSynth::silence_length_;
+
 /* static */
 uint32_t DrumSynth::last_event_time_;
 
+/* static */
+bool DrumSynth::triggered_;
+
+/* static */
+uint16_t DrumSynth::render_time_;
+
+/* static */
+DrumEvent DrumSynth::events_[kDrumEventQueueSize];
+
+/* static */
+uint8_t DrumSynth::event_read_ptr_;
+
+/* static */
+uint8_t DrumSynth::event_write_ptr_;
+
+/* static */
+const prog_uint8_t* DrumSynth::hh_sample_;
+
 static const prog_uint8_t preset_bd_1[] PROGMEM = { 60, 18, 104, 120, 0 };
 static const prog_uint8_t preset_bd_2[] PROGMEM = { 56, 60, 120, 150, 0 };
 static const prog_uint8_t preset_bd_3[] PROGMEM = { 60, 42, 130, 180, 14 };
@@ -83,6 +110,12 @@ static const prog_uint8_t preset_hh_3[] PROGMEM = { 134, 0, 0, 90, 32 };
 static const prog_uint8_t preset_hh_4[] PROGMEM = { 134, 0, 0, 90, 255 };
 static const prog_uint8_t preset_hh_5[] PROGMEM = { 134, 0, 0, 45, 255 };
 
+#if NUM_HH_SAMPLES > 0
+// The samples carry their own decay, the amplitude envelope only shortens
+// them.
+static const uint8_t kHhSampleAmpDecay = 128;
+#endif  // NUM_HH_SAMPLES > 0
+
 static const prog_uint8_t* drum_presets[] = {
   preset_bd_1,
   preset_bd_2,
@@ -106,28 +139,70 @@ static const prog_uint8_t* drum_presets[] = {
 /* static */
 void DrumSynth::Init() {
   memset(state_, 0, sizeof(DrumState) * kNumDrumInstruments);
+  event_read_ptr_ = event_write_ptr_ = 0;
+  idle_ = false;
+  silence_length_ = 0;
+  for (uint8_t i = 0; i < kNumDrumInstruments; ++i) {
+    UpdateTriggerState(i);
+  }
 }
 
 /* static */
 void DrumSynth::Trigger(uint8_t instrument, uint8_t level) {
-  last_event_time_ = milliseconds();
-  
+  triggered_ = true;
+  playing_ = true;
+  idle_ = false;
+  uint8_t w = event_write_ptr_;
+  uint8_t next = (w + 1) & (kDrumEventQueueSize - 1);
+  if (next == event_read_ptr_) {
+    // Queue full, trigger at the next block boundary.
+    TriggerNow(instrument, level);
+    return;
+  }
+  // The position of the audio ISR, in render time, is the number of samples
+  // written minus the number of samples still waiting in the buffer. All
+  // events are scheduled a full buffer later - which is the latest sample
+  // the renderer can have already written.
+  events_[w].time = render_time_ - audio_buffer.readable() + \
+      (AUDIO_BUFFER_SIZE - 1);
+  events_[w].instrument = instrument;
+  events_[w].level = level;
+  event_write_ptr_ = next;
+}
+
+/* static */
+void DrumSynth::TriggerNow(uint8_t instrument, uint8_t level) {
   // Reset all phases.
   state_[instrument].phase = 0;
   state_[instrument].pitch_env_phase = 0;
   state_[instrument].amp_env_phase = 0;
   
   // Initialize envelope increments
-  state_[instrument].pitch_env_increment = pgm_read_word(
-      lut_res_drm_env_increments + patch_[instrument].pitch_decay);
-  state_[instrument].amp_env_increment = pgm_read_word(
-      lut_res_drm_env_increments + patch_[instrument].amp_decay);
+  state_[instrument].pitch_env_increment = \
+      trigger_state_[instrument].pitch_env_increment;
+  state_[instrument].amp_env_increment = \
+      trigger_state_[instrument].amp_env_increment;
   state_[instrument].level = U8U8MulShift8(level, patch_[instrument].level);
   playing_ = true;
 }
 
 /* static */
 void DrumSynth::MorphPatch(uint8_t instrument, uint8_t value) {
+#if NUM_HH_SAMPLES > 0
+  if (instrument == 2) {
+    if (value >= kHhSampleToneThreshold) {
+      // Each sample gets an equal share of the range, in which the tone sets
+      // the playback rate from 0.75x to 1.19x.
+      uint8_t position = (value - kHhSampleToneThreshold) * NUM_HH_SAMPLES;
+      hh_sample_ = hh_sample_table[position >> 6];
+      patch_[2].pitch = 32 + (position & 0x3f);
+      patch_[2].amp_decay = kHhSampleAmpDecay;
+      UpdateTriggerState(2);
+      return;
+    }
+    hh_sample_ = NULL;
+  }
+#endif  // NUM_HH_SAMPLES > 0
   uint8_t offset = instrument * 5 + (value >> 6);
   uint8_t balance = value << 2;
   const prog_uint8_t* a = drum_presets[offset];
@@ -136,6 +211,15 @@ void DrumSynth::MorphPatch(uint8_t instrument, uint8_t value) {
   for (uint8_t i = 0; i < 5; ++i) {
     address[i] = U8Mix(pgm_read_byte(a + i), pgm_read_byte(b + i), balance);
   }
+  UpdateTriggerState(instrument);
+}
+
+/* static */
+void DrumSynth::UpdateTriggerState(uint8_t instrument) {
+  trigger_state_[instrument].pitch_env_increment = pgm_read_word(
+      lut_res_drm_env_increments + patch_[instrument].pitch_decay);
+  trigger_state_[instrument].amp_env_increment = pgm_read_word(
+      lut_res_drm_env_increments + patch_[instrument].amp_decay);
 }
 
 static const prog_uint8_t drums_cc_map[] PROGMEM = {
@@ -157,6 +241,7 @@ void DrumSynth::SetParameterCc(uint8_t cc, uint8_t value) {
   uint8_t address = pgm_read_byte(drums_cc_map + cc - 16);
   uint8_t* data = static_cast<uint8_t*>(static_cast<void*>(patch_));
   data[address] = value << 1;
+  UpdateTriggerState(address / sizeof(DrumPatch));
 }
 
 /* static */
@@ -187,92 +272,195 @@ void DrumSynth::FillWithSilence() {
       fade_counter_ = 255;
       --sample_;
     }
+    silence_length_ = 0;
   }
   while (audio_buffer.writable()) {
     audio_buffer.Overwrite(sample_);
+    ++render_time_;
+    if (!sample_ && silence_length_ < AUDIO_BUFFER_SIZE) {
+      ++silence_length_;
+    }
+  }
+  if (silence_length_ == AUDIO_BUFFER_SIZE) {
+    idle_ = true;
   }
 }
 
 /* static */
-void DrumSynth::Render() {
+inline uint8_t DrumSynth::active_instruments() {
+  // An instrument whose amplitude has decayed to 0 will stay silent until
+  // it is triggered again - which resets its phases, so there is no need to
+  // keep them running in the meantime.
+  uint8_t active = 0;
+  if (state_[0].amp_level) {
+    active |= DRUM_ACTIVE_BD;
+  }
+  if (state_[1].amp_level | state_[1].amp_level_noise) {
+    active |= DRUM_ACTIVE_SD;
+  }
+  if (state_[2].amp_level) {
+    active |= hh_sample_ ? DRUM_ACTIVE_HH_SAMPLE : DRUM_ACTIVE_HH;
+  }
+  return active;
+}
+
+/* static */
+template<uint8_t active>
+void DrumSynth::RenderBlock(uint8_t size) {
+  // When the bandwidth is reduced, only 1 sample out of sample_rate_ + 1 is
+  // computed; the phases jump by the corresponding number of samples and the
+  // last computed sample is held in between.
   uint8_t sample = sample_;
-  uint8_t sample_counter = sample_counter_;
-  while (audio_buffer.writable() >= kAudioBlockSize) {
-    UpdateModulations();
-    uint8_t noise = Random::state_msb();
-    uint16_t phase_0 = state_[0].phase;
-    uint16_t phase_1 = state_[1].phase;
-    uint16_t phase_2 = state_[2].phase;
-    uint16_t phase_2b = state_[2].pitch_env_phase; // pitch_env_phase used as 2nd phase for hi-hat
-    const int8_t hhnoisesample = 120 - S8U8MulShift8(80, state_[2].amp_level_noise); // modulation of noise level for Hi-hat/Cymbal morph
-    for (uint8_t i = 0; i < kAudioBlockSize; ++i) {
-      ++sample_counter;
-      int16_t mix = 128;
+  uint8_t step = sample_rate_ + 1;
+  uint8_t next = sample_counter_ < sample_rate_
+      ? sample_rate_ - sample_counter_
+      : 0;
+  
+  // Rewind the phases so that the first jump lands on sample "next".
+  int8_t rewind = next + 1 - step;
+  uint16_t increment_0 = state_[0].phase_increment;
+  uint16_t increment_1 = state_[1].phase_increment;
+  uint16_t increment_2 = state_[2].phase_increment;
+  uint16_t increment_2b = state_[2].pitch_env_increment; // pitch_env_increment updates 2nd phase for hi-hat
+  uint16_t phase_0 = state_[0].phase + increment_0 * rewind;
+  uint16_t phase_1 = state_[1].phase + increment_1 * rewind;
+  uint16_t phase_2 = state_[2].phase + increment_2 * rewind;
+  uint16_t phase_2b = state_[2].pitch_env_phase + increment_2b * rewind; // pitch_env_phase used as 2nd phase for hi-hat
+  increment_0 *= step;
+  increment_1 *= step;
+  increment_2 *= step;
+  increment_2b *= step;
+  
+  const prog_uint8_t* hh_sample = hh_sample_;
+  uint8_t noise = Random::state_msb();
+  const int8_t hhnoisesample = 120 - S8U8MulShift8(80, state_[2].amp_level_noise); // modulation of noise level for Hi-hat/Cymbal morph
+  const int8_t hh_samples[] = {
+    120,  // OPL2 sinlookup = 0xd0
+    hhnoisesample,  // OPL2 sinlookup = 0x34 with noise
+    -120,  // OPL2 sinlookup = 0x234
+    static_cast<int8_t>(-hhnoisesample)  // OPL2 sinlookup = 0x2d0 with noise
+  };
+  for (uint8_t i = 0; i < size; ++i) {
+    if (active & (DRUM_ACTIVE_SD | DRUM_ACTIVE_HH)) {
       noise = (noise * 73) + 1;
-
-      phase_0 += state_[0].phase_increment;
-      phase_1 += state_[1].phase_increment;
-      phase_2 += state_[2].phase_increment;
-      phase_2b += state_[2].pitch_env_increment; // pitch_env_increment updates 2nd phase for hi-hat
+    }
+    if (i == next) {
+      next += step;
+      int16_t mix = 128;
       
-      // Linear interpolation optimized for the case when the delta
-      // between adjacent samples is in the -127..+127 range.
-      Word bd_sample_pair;
-      bd_sample_pair.value = pgm_read_word(wav_res_sine + (phase_0 >> 8));
-      int8_t bd = bd_sample_pair.bytes[0];
-      int8_t bd_2 = bd_sample_pair.bytes[1];
-      bd += S8U8MulShift8(bd_2 - bd, phase_0);
-      mix += S8U8MulShift8(bd, state_[0].amp_level);
-
-      int8_t sd = pgm_read_byte(wav_res_sine + (phase_1 >> 8));
-      mix += S8U8MulShift8(sd, state_[1].amp_level);
-      mix += S8U8MulShift8(noise, state_[1].amp_level_noise);
-
-      // Mimic OPL2/YM3812 style hi-hat
-      const uint8_t hibits_phase_2 = phase_2 >> 8;
-      const uint8_t bit2 = (hibits_phase_2 & 0x04);
-      const uint8_t bit3 = (hibits_phase_2 & 0x08);
-      const uint8_t bit7 = (hibits_phase_2 & 0x80);
-      const uint8_t res1 = bit3 || ((bit2 || bit7) && !(bit2 && bit7)); // bit3 | bit2 ^ bit7
-      const uint8_t hibits_phase_2b = phase_2b >> 8;
-      const uint8_t bit3e = (hibits_phase_2b & 0x08);
-      const uint8_t bit5e = (hibits_phase_2b & 0x20);
-      const uint8_t res2 = ((bit3e || bit5e) && !(bit3e && bit5e)); // bit3e ^ bit5e
-      int8_t hhsample;
-      if (res2 || res1) {
-        if (noise & 0x1) {
-          hhsample = -hhnoisesample; // OPL2 sinlookup = 0x2d0 with noise
-        }
-        else {
-          hhsample = -120; // OPL2 sinlookup = 0x234
-        }
-      } 
-      else {
-        if (noise & 0x1) { 
-          hhsample = hhnoisesample; // OPL2 sinlookup = 0x34 with noise
-        }
-        else {
-          hhsample = 120; // OPL2 sinlookup = 0xd0
-        }
+      if (active & DRUM_ACTIVE_BD) {
+        phase_0 += increment_0;
+        // Linear interpolation optimized for the case when the delta
+        // between adjacent samples is in the -127..+127 range.
+        Word bd_sample_pair;
+        bd_sample_pair.value = pgm_read_word(wav_res_sine + (phase_0 >> 8));
+        int8_t bd = bd_sample_pair.bytes[0];
+        int8_t bd_2 = bd_sample_pair.bytes[1];
+        bd += S8U8MulShift8(bd_2 - bd, phase_0);
+        mix += S8U8MulShift8(bd, state_[0].amp_level);
       }
       
-      mix += S8U8MulShift8(hhsample, state_[2].amp_level);
+      if (active & DRUM_ACTIVE_SD) {
+        phase_1 += increment_1;
+        int8_t sd = pgm_read_byte(wav_res_sine + (phase_1 >> 8));
+        mix += S8U8MulShift8(sd, state_[1].amp_level);
+        mix += S8U8MulShift8(noise, state_[1].amp_level_noise);
+      }
       
-      if (sample_counter > sample_rate_) {
-        if (mix > 255) mix = 255;
-        if (mix < 0) mix = 0;
-        sample = mix;
-        sample_counter = 0;
+      if (active & DRUM_ACTIVE_HH) {
+        phase_2 += increment_2;
+        phase_2b += increment_2b;
+        // Mimic OPL2/YM3812 style hi-hat: bit3 | bit2 ^ bit7 of the 1st
+        // operator, bit3 ^ bit5 of the 2nd operator and the noise bit are
+        // combined into an index. The table gives the waveform sample to use.
+        uint8_t hh_index = (phase_2 >> 8) & 0x8c;
+        hh_index |= ((phase_2b >> 8) & 0x28) << 1;
+        hh_index |= noise & 0x1;
+        int8_t hhsample = hh_samples[pgm_read_byte(wav_res_hh_opl2 + hh_index)];
+        mix += S8U8MulShift8(hhsample, state_[2].amp_level);
       }
-      audio_buffer.Overwrite(sample);
+      
+      if (active & DRUM_ACTIVE_HH_SAMPLE) {
+        phase_2 += increment_2;
+        int8_t hhsample = pgm_read_byte(hh_sample + (phase_2 >> 4));
+        mix += S8U8MulShift8(hhsample, state_[2].amp_level);
+      }
+      
+      if (mix > 255) mix = 255;
+      if (mix < 0) mix = 0;
+      sample = mix;
     }
-    state_[0].phase = phase_0;
-    state_[1].phase = phase_1;
-    state_[2].phase = phase_2;
-    state_[2].pitch_env_phase = phase_2b; // pitch_env_phase used as 2nd phase for hi-hat
+    audio_buffer.Overwrite(sample);
+  }
+  if (active & DRUM_ACTIVE_BD) {
+    state_[0].phase += state_[0].phase_increment * size;
+  }
+  if (active & DRUM_ACTIVE_SD) {
+    state_[1].phase += state_[1].phase_increment * size;
+  }
+  if (active & DRUM_ACTIVE_HH) {
+    state_[2].phase += state_[2].phase_increment * size;
+    state_[2].pitch_env_phase += state_[2].pitch_env_increment * size;
+  }
+  if (active & DRUM_ACTIVE_HH_SAMPLE) {
+    state_[2].phase += state_[2].phase_increment * size;
   }
   sample_ = sample;
-  sample_counter_ = sample_counter;
+  sample_counter_ = step + size - 1 - next;
+}
+
+/* static */
+void DrumSynth::RenderSamples(uint8_t size) {
+  // Dispatch to a render loop specialized for the instruments currently
+  // audible.
+  switch (active_instruments()) {
+    case 0: RenderBlock<0>(size); break;
+    case 1: RenderBlock<1>(size); break;
+    case 2: RenderBlock<2>(size); break;
+    case 3: RenderBlock<3>(size); break;
+    case 4: RenderBlock<4>(size); break;
+    case 5: RenderBlock<5>(size); break;
+    case 6: RenderBlock<6>(size); break;
+    case 7: RenderBlock<7>(size); break;
+#if NUM_HH_SAMPLES > 0
+    case 8: RenderBlock<8>(size); break;
+    case 9: RenderBlock<9>(size); break;
+    case 10: RenderBlock<10>(size); break;
+    case 11: RenderBlock<11>(size); break;
+#endif  // NUM_HH_SAMPLES > 0
+  }
+  render_time_ += size;
+}
+
+/* static */
+void DrumSynth::Render() {
+  idle_ = false;
+  silence_length_ = 0;
+  while (audio_buffer.writable() >= kAudioBlockSize) {
+    UpdateModulations();
+    // The block is split at the position of each pending event.
+    uint8_t remaining = kAudioBlockSize;
+    while (remaining) {
+      uint8_t size = remaining;
+      uint8_t r = event_read_ptr_;
+      if (r != event_write_ptr_) {
+        int16_t delay = events_[r].time - render_time_;
+        if (delay <= 0) {
+          TriggerNow(events_[r].instrument, events_[r].level);
+          ComputeModulations(events_[r].instrument);
+          event_read_ptr_ = (r + 1) & (kDrumEventQueueSize - 1);
+          continue;
+        } else if (delay < size) {
+          size = delay;
+        }
+      }
+      RenderSamples(size);
+      remaining -= size;
+    }
+  }
+  if (event_read_ptr_ != event_write_ptr_) {
+    playing_ = true;
+  }
   fade_counter_ = 255;
 }
 
@@ -289,47 +477,74 @@ void DrumSynth::UpdateModulations() {
     else {
       playing_ = true;
     }
-    state_[i].amp_level = U8U8MulShift8(
-        state_[i].level,
-        InterpolateSample(wav_res_drm_envelope, state_[i].amp_env_phase));
-    
-    // Compute pitch
-    uint16_t pitch = static_cast<uint16_t>(patch_[i].pitch) << 8;
-    if (i == 0) { // add pitch crunchiness mod for BD
-      pitch += U8U8Mul(Random::GetByte(), patch_[i].crunchiness);
+#if NUM_HH_SAMPLES > 0
+    if (i == 2 && hh_sample_ && state_[2].phase >= kHhSampleEnd) {
+      // End of the sample.
+      state_[2].amp_env_phase = 0xffff;
+      state_[2].amp_env_increment = 0;
     }
-    if (i != 2) { // add pitch envelope mod for BD/SD
+#endif  // NUM_HH_SAMPLES > 0
+    if (i != 2) { // step pitch envelope for BD/SD
       state_[i].pitch_env_phase += state_[i].pitch_env_increment;
       if (state_[i].pitch_env_phase < state_[i].pitch_env_increment) {
         state_[i].pitch_env_phase = 0xffff;
         state_[i].pitch_env_increment = 0;
       }
-      pitch += U8U8Mul(
-        patch_[i].pitch_mod,
-        InterpolateSample(wav_res_drm_envelope, state_[i].pitch_env_phase));
-    }
-    // Compute phase increment from pitch
-    state_[i].phase_increment = InterpolateIncreasing(
-        lut_res_drm_phase_increments,
-        pitch);
-    if (i == 2) {
-      // pitch_env_increment used as 2nd phase for hi-hat, hardwired to 2/3 of 1st operator
-      state_[i].pitch_env_increment = state_[i].phase_increment;
-      state_[i].phase_increment = (state_[i].phase_increment * 3) / 2;
     }
+    ComputeModulations(i);
+  }
+}
+
+/* static */
+void DrumSynth::ComputeModulations(uint8_t i) {
+  state_[i].amp_level = U8U8MulShift8(
+      state_[i].level,
+      InterpolateSample(wav_res_drm_envelope, state_[i].amp_env_phase));
+  
+#if NUM_HH_SAMPLES > 0
+  if (i == 2 && hh_sample_) {
+    // The sample is played at 0.75x to 1.19x its rate.
+    state_[2].phase_increment = 8 + (patch_[2].pitch >> 3);
+    return;
+  }
+#endif  // NUM_HH_SAMPLES > 0
+  
+  // Compute pitch
+  uint16_t pitch = static_cast<uint16_t>(patch_[i].pitch) << 8;
+  if (i == 0) { // add pitch crunchiness mod for BD
+    pitch += U8U8Mul(Random::GetByte(), patch_[i].crunchiness);
+  }
+  if (i != 2) { // add pitch envelope mod for BD/SD
+    pitch += U8U8Mul(
+      patch_[i].pitch_mod,
+      InterpolateSample(wav_res_drm_envelope, state_[i].pitch_env_phase));
+  }
+  // Compute phase increment from pitch
+  state_[i].phase_increment = InterpolateIncreasing(
+      lut_res_drm_phase_increments,
+      pitch);
+  if (i == 1) {
+    state_[1].amp_level_noise = U8U8MulShift8(
+        state_[1].amp_level,
+        patch_[1].crunchiness);
+    state_[1].amp_level = U8U8MulShift8(
+        state_[1].amp_level,
+        ~patch_[1].crunchiness);
+  } else if (i == 2) {
+    // pitch_env_increment used as 2nd phase for hi-hat, hardwired to 2/3 of 1st operator
+    state_[2].pitch_env_increment = state_[2].phase_increment;
+    state_[2].phase_increment = (state_[2].phase_increment * 3) / 2;
+    state_[2].amp_level_noise = patch_[2].crunchiness; // crunchiness for hi-hat noise
   }
-  state_[1].amp_level_noise = U8U8MulShift8(
-      state_[1].amp_level,
-      patch_[1].crunchiness);
-  state_[1].amp_level = U8U8MulShift8(
-      state_[1].amp_level,
-      ~patch_[1].crunchiness);
-  state_[2].amp_level_noise = patch_[2].crunchiness; // crunchiness for hi-hat noise
 }
 
 /* static */
 uint32_t DrumSynth::idle_time_ms() {
   uint32_t now = milliseconds();
+  if (triggered_) {
+    triggered_ = false;
+    last_event_time_ = now;
+  }
   return now - last_event_time_;
 }
 
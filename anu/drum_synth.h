@@ -20,10 +20,30 @@
 
 #include "avrlib/base.h"
 
+#include <avr/pgmspace.h>
+
+#include "anu/hh_samples.h"
+
 namespace anu {
 
 static const uint8_t kNumDrumInstruments = 3;
 
+// When hi-hat samples are embedded (909, Linn, DT), the top quarter of the HH
+// tone range selects them instead of the synthesized hi-hats. Samples are
+// played with a 12.4 phase. The playback stops a little before the end, so
+// that a block never reads past it.
+static const uint16_t kHhSampleEnd = (kHhSampleSize - 128) << 4;
+static const uint8_t kHhSampleToneThreshold = 192;
+
+static const uint8_t kDrumEventQueueSize = 8;
+
+enum DrumActiveFlags {
+  DRUM_ACTIVE_BD = 1,
+  DRUM_ACTIVE_SD = 2,
+  DRUM_ACTIVE_HH = 4,
+  DRUM_ACTIVE_HH_SAMPLE = 8
+};
+
 struct DrumPatch {
   uint8_t pitch;
   uint8_t pitch_decay;
@@ -45,11 +65,29 @@ struct DrumState {
   uint8_t level;
 };
 
+// Envelope increments of an instrument, read from the patch when it changes
+// rather than on each trigger.
+struct DrumTriggerState {
+  uint16_t pitch_env_increment;
+  uint16_t amp_env_increment;
+};
+
+struct DrumEvent {
+  uint16_t time;
+  uint8_t instrument;
+  uint8_t level;
+};
+
 class DrumSynth {
  public:
   DrumSynth() { }
   ~DrumSynth() { }
   static void Init();
+  
+  // Triggers are not applied immediately, but queued and rendered at a fixed
+  // latency (the depth of the audio buffer) from the moment they are
+  // received, so that their timing does not depend on where the render loop
+  // is in its block.
   static void Trigger(uint8_t instrument, uint8_t velocity);
   static void SetParameterCc(uint8_t cc, uint8_t value);
   static void MorphPatch(uint8_t instrument, uint8_t value);
@@ -60,18 +98,50 @@ class DrumSynth {
   static uint32_t idle_time_ms();
   static bool playing() { return playing_; }
   
+  // Set once the output has faded to 0 and the audio buffer holds nothing
+  // else. The audio ISR then stops reading the buffer, so it stays full and
+  // FillWithSilence() has nothing to do, until Trigger() or Render() are
+  // called again.
+  static bool idle() { return idle_; }
+  
  private:
+  static void TriggerNow(uint8_t instrument, uint8_t velocity);
+  static void UpdateTriggerState(uint8_t instrument);
   static void UpdateModulations();
+  static void ComputeModulations(uint8_t instrument);
+  static uint8_t active_instruments();
+  static void RenderSamples(uint8_t size);
+  
+  template<uint8_t active>
+  static void RenderBlock(uint8_t size);
   
   static DrumPatch patch_[kNumDrumInstruments];
   static DrumState state_[kNumDrumInstruments];
+  static DrumTriggerState trigger_state_[kNumDrumInstruments];
   
   static uint8_t sample_;
   static uint8_t sample_counter_;
   static uint8_t sample_rate_;
   static uint8_t fade_counter_;
+  // The time of the last trigger is only read when idle_time_ms() is called,
+  // to keep milliseconds() out of Trigger().
   static uint32_t last_event_time_;
+  static bool triggered_;
   static bool playing_;
+  static bool idle_;
+  
+  // Number of 0 samples written since the output has faded out.
+  static uint16_t silence_length_;
+  
+  // Number of samples written to the audio buffer, used as the time base of
+  // the event queue.
+  static uint16_t render_time_;
+  static DrumEvent events_[kDrumEventQueueSize];
+  static uint8_t event_read_ptr_;
+  static uint8_t event_write_ptr_;
+  
+  // Sample played in the HH slot, or NULL for the synthesized hi-hat.
+  static const prog_uint8_t* hh_sample_;
   
   DISALLOW_COPY_AND_ASSIGN(DrumSynth);
 };
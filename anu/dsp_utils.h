@@ -15,8 +15,12 @@
 //
 // -----------------------------------------------------------------------------
 //
-// A set of basic operands, especially useful for fixed-point arithmetic, with
-// fast ASM implementations.
+// A set of basic operands, especially useful for fixed-point arithmetic. Only
+// U32U16MulShift16 has its own ASM implementation, used when USE_OPTIMIZED_OP
+// is defined as in avrlib/op.h; Mix and InterpolateIncreasing are portable
+// code built on the avrlib/op.h multiplications, which have theirs. On the
+// host, anu/test checks that they are bit-exact with wide integer arithmetic
+// and times them - in host cycles, not AVR ones.
 
 #ifndef ANU_DSP_UTILS_H_
 #define ANU_DSP_UTILS_H_
@@ -48,6 +52,71 @@ inline uint16_t Mix(uint16_t a, uint16_t b, uint16_t balance) {
   }
 }
 
+#ifdef USE_OPTIMIZED_OP
+
+// Bytes 2 to 5 of the 48-bit product, accumulated from the 8 partial 8x8
+// products. The portable version compiles into two 32x32 multiplication
+// calls.
+inline uint32_t U32U16MulShift16(uint32_t a, uint16_t b) {
+  uint32_t result;
+  uint8_t byte_1;
+  uint8_t zero;
+  asm(
+    "clr %[zero]"                 "\n\t"
+    "clr %A[result]"              "\n\t"
+    "clr %B[result]"              "\n\t"
+    "clr %C[result]"              "\n\t"
+    "clr %D[result]"              "\n\t"
+    // Byte 1.
+    "mul %A[a], %A[b]"            "\n\t"
+    "mov %[byte_1], r1"           "\n\t"
+    "mul %A[a], %B[b]"            "\n\t"
+    "add %[byte_1], r0"           "\n\t"
+    "adc %A[result], r1"          "\n\t"
+    "adc %B[result], %[zero]"     "\n\t"
+    "mul %B[a], %A[b]"            "\n\t"
+    "add %[byte_1], r0"           "\n\t"
+    "adc %A[result], r1"          "\n\t"
+    "adc %B[result], %[zero]"     "\n\t"
+    // Byte 2.
+    "mul %B[a], %B[b]"            "\n\t"
+    "add %A[result], r0"          "\n\t"
+    "adc %B[result], r1"          "\n\t"
+    "adc %C[result], %[zero]"     "\n\t"
+    "mul %C[a], %A[b]"            "\n\t"
+    "add %A[result], r0"          "\n\t"
+    "adc %B[result], r1"          "\n\t"
+    "adc %C[result], %[zero]"     "\n\t"
+    // Byte 3.
+    "mul %C[a], %B[b]"            "\n\t"
+    "add %B[result], r0"          "\n\t"
+    "adc %C[result], r1"          "\n\t"
+    "adc %D[result], %[zero]"     "\n\t"
+    "mul %D[a], %A[b]"            "\n\t"
+    "add %B[result], r0"          "\n\t"
+    "adc %C[result], r1"          "\n\t"
+    "adc %D[result], %[zero]"     "\n\t"
+    // Byte 4.
+    "mul %D[a], %B[b]"            "\n\t"
+    "add %C[result], r0"          "\n\t"
+    "adc %D[result], r1"          "\n\t"
+    "clr r1"                      "\n\t"
+    : [result] "=&r" (result), [byte_1] "=&r" (byte_1), [zero] "=&r" (zero)
+    : [a] "r" (a), [b] "r" (b)
+  );
+  return result;
+}
+
+#else
+
+inline uint32_t U32U16MulShift16(uint32_t a, uint16_t b) {
+  uint32_t high = static_cast<uint32_t>(static_cast<uint16_t>(a >> 16)) * b;
+  uint32_t low = static_cast<uint32_t>(static_cast<uint16_t>(a)) * b;
+  return high + (low >> 16);
+}
+
+#endif  // USE_OPTIMIZED_OP
+
 inline uint16_t InterpolateIncreasing(
     const prog_uint16_t* table,
     uint16_t phase) {
@@ -56,6 +125,22 @@ inline uint16_t InterpolateIncreasing(
   return a + U16U8MulShift8(b - a, phase);
 }
 
+// Decodes a 32-bit value stored on 16 bits as a 4-bit exponent and a 12-bit
+// mantissa, by ExponentEncode in resources/lookup_tables.py. The shift by 8 is
+// a byte move, so that at most 7 single bit shifts are left.
+inline uint32_t DecodeExponent(uint16_t value) {
+  uint32_t mantissa = (value & 0x0fff) | 0x1000;
+  uint8_t exponent = value >> 12;
+  if (exponent & 8) {
+    mantissa <<= 8;
+  }
+  return mantissa << (exponent & 7);
+}
+
+inline uint32_t ReadExponentTable(const prog_uint16_t* table, uint8_t index) {
+  return DecodeExponent(pgm_read_word(table + index));
+}
+
 }  // namespace anu
 
 #endif  // ANU_DSP_UTILS_H__
\ No newline at end of file
@@ -32,6 +32,16 @@ enum EnvelopeSegment {
   ENV_NUM_SEGMENTS,
 };
 
+// The segments are exponential curves computed by recurrence rather than by
+// interpolating a table. The distance to an asymptote placed slightly beyond
+// the target of the segment is scaled down at each sample by a constant
+// factor, such that the target is reached after as many samples as it took the
+// phase accumulator of the table-based version to overflow. The distance is
+// stored in 16.15 fixed point.
+//
+// exp(-4) / (1 - exp(-4)) * 32768.
+static const uint16_t kEnvelopeOvershoot = 611;
+
 class Envelope {
  public:
   Envelope() { }
@@ -42,9 +52,13 @@ class Envelope {
     target_[ENV_SEGMENT_RELEASE] = 0;
     target_[ENV_SEGMENT_DEAD] = 0;
     
-    increment_[ENV_SEGMENT_SUSTAIN] = 0;
-    increment_[ENV_SEGMENT_DEAD] = 0;
+    coefficient_[ENV_SEGMENT_SUSTAIN] = 0;
+    coefficient_[ENV_SEGMENT_DEAD] = 0;
+    shift_[ENV_SEGMENT_SUSTAIN] = 0;
+    shift_[ENV_SEGMENT_DEAD] = 0;
     segment_ = ENV_SEGMENT_DEAD;
+    value_ = 0;
+    linked_ = false;
   }
 
   inline EnvelopeSegment segment() const {
@@ -56,9 +70,9 @@ class Envelope {
   }
   
   inline void Update(uint8_t a, uint8_t d, uint8_t s, uint8_t r) {
-    increment_[ENV_SEGMENT_ATTACK] = pgm_read_dword(lut_res_env_increments + a);
-    increment_[ENV_SEGMENT_DECAY] = pgm_read_dword(lut_res_env_increments + d);
-    increment_[ENV_SEGMENT_RELEASE] = pgm_read_dword(lut_res_env_increments + r);
+    SetCoefficient(ENV_SEGMENT_ATTACK, a);
+    SetCoefficient(ENV_SEGMENT_DECAY, d);
+    SetCoefficient(ENV_SEGMENT_RELEASE, r);
     target_[ENV_SEGMENT_SUSTAIN] = target_[ENV_SEGMENT_DECAY] = s << 8;
   }
   
@@ -69,30 +83,83 @@ class Envelope {
     a_ = value_;
     b_ = target_[segment];
     segment_ = segment;
-    phase_ = 0;
+    linked_ = false;
+    uint16_t span = b_ > a_ ? b_ - a_ : a_ - b_;
+    end_distance_ = static_cast<uint32_t>(span) * kEnvelopeOvershoot;
+    distance_ = (static_cast<uint32_t>(span) << 15) + end_distance_;
+  }
+  
+  // Makes this envelope copy the output of "leader" for as long as both
+  // envelopes render the same segment, with the same start point, target and
+  // time constant. To be called right after both envelopes have been
+  // triggered.
+  inline void Link(const Envelope& leader) {
+    linked_ = segment_ == leader.segment_ &&
+        a_ == leader.a_ &&
+        b_ == leader.b_ &&
+        coefficient_[segment_] == leader.coefficient_[segment_] &&
+        shift_[segment_] == leader.shift_[segment_];
   }
 
   inline uint16_t Render() {
-    uint32_t increment = increment_[segment_];
-    phase_ += increment;
-    if (phase_ < increment) {
-      value_ = Mix(a_, b_, 65535);
-      Trigger(static_cast<EnvelopeSegment>(segment_ + 1));
-    }
-    if (increment_[segment_]) {
-      value_ = Mix(
-          a_,
-          b_,
-          InterpolateIncreasing(lut_res_env_expo, phase_ >> 16));
+    uint16_t coefficient = coefficient_[segment_];
+    if (coefficient) {
+      uint32_t step = U32U16MulShift16(distance_, coefficient);
+      step = (step >> shift_[segment_]) + 1;
+      if (distance_ <= end_distance_ + step) {
+        value_ = b_;
+        Trigger(static_cast<EnvelopeSegment>(segment_ + 1));
+      } else {
+        distance_ -= step;
+        uint16_t delta = (distance_ - end_distance_) >> 15;
+        value_ = b_ > a_ ? b_ - delta : b_ + delta;
+      }
     }
     return value_;
   }
   
+  // Renders an envelope which has been linked to "leader", after the leader
+  // has been rendered.
+  inline uint16_t Render(const Envelope& leader) {
+    if (linked_) {
+      if (segment_ != leader.segment_) {
+        // The leader has completed the shared segment.
+        value_ = b_;
+        Trigger(static_cast<EnvelopeSegment>(segment_ + 1));
+        Link(leader);
+        return value_;
+      } else if (coefficient_[segment_] == leader.coefficient_[segment_] &&
+                 shift_[segment_] == leader.shift_[segment_]) {
+        value_ = leader.value_;
+        return value_;
+      } else {
+        // The time constant of one of the envelopes has been edited in the
+        // middle of the shared segment.
+        distance_ = leader.distance_;
+        linked_ = false;
+      }
+    }
+    return Render();
+  }
+  
   inline uint16_t value() const { return value_; }
 
  private:
-  // Phase increments for each segment.
-  uint32_t increment_[ENV_NUM_SEGMENTS];
+  inline void SetCoefficient(EnvelopeSegment segment, uint8_t time) {
+    uint32_t coefficient = pgm_read_dword(lut_res_env_coefficients + time);
+    uint8_t shift = 0;
+    while (shift < 16 && !(coefficient & 0x80000000)) {
+      coefficient <<= 1;
+      ++shift;
+    }
+    coefficient_[segment] = coefficient >> 16;
+    shift_[segment] = shift;
+  }
+  
+  // Rate at which the distance to the asymptote shrinks for each segment,
+  // stored as a 16-bit mantissa and a right shift.
+  uint16_t coefficient_[ENV_NUM_SEGMENTS];
+  uint8_t shift_[ENV_NUM_SEGMENTS];
   
   // Value that needs to be reached at the end of each segment.
   uint16_t target_[ENV_NUM_SEGMENTS];
@@ -105,8 +172,13 @@ class Envelope {
   uint16_t b_;
   uint16_t value_;
 
-  uint32_t phase_increment_;
-  uint32_t phase_;
+  // Distance to the asymptote, and distance between the asymptote and the
+  // target, at which the segment ends.
+  uint32_t distance_;
+  uint32_t end_distance_;
+  
+  // The current segment is identical to the leader's.
+  bool linked_;
 
   DISALLOW_COPY_AND_ASSIGN(Envelope);
 };
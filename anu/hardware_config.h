@@ -38,7 +38,6 @@ using avrlib::PortC;
 using avrlib::PortD;
 using avrlib::PwmChannel1B;
 using avrlib::RingBuffer;
-using avrlib::SerialInput;
 using avrlib::SerialPort0;
 using avrlib::ShiftRegisterOutput;
 using avrlib::SpiMaster;
@@ -51,7 +50,23 @@ typedef avrlib::Serial<
     31250,
     avrlib::POLLED,
     avrlib::POLLED> MidiIO;
-typedef RingBuffer<SerialInput<SerialPort0> > MidiBuffer;
+
+// Depth of the MIDI input buffer, filled by the UART RX interrupt. Must be a
+// power of 2, 256 at most. At 31250 bauds, each byte buffers 0.32ms of main
+// loop stall.
+#ifndef MIDI_IN_BUFFER_SIZE
+#define MIDI_IN_BUFFER_SIZE 64
+#endif  // MIDI_IN_BUFFER_SIZE
+
+struct MidiBufferSpecs {
+  typedef uint8_t Value;
+  enum {
+    buffer_size = MIDI_IN_BUFFER_SIZE,
+    data_size = 8,
+  };
+};
+
+typedef RingBuffer<MidiBufferSpecs> MidiBuffer;
 
 // IO
 typedef Gpio<PortD, 6> IOClockLine;
@@ -0,0 +1,1590 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Hi-hat samples.
+//
+// Automatically generated with:
+// make -f anu/makefile hh_samples
+
+#include "anu/hh_samples.h"
+
+namespace anu {
+
+#if NUM_HH_SAMPLES > 0
+static const prog_uint8_t hh_sample_909[] PROGMEM = {
+     255,    253,      5,    239,     78,     20,    174,     24,
+      59,     84,    230,    128,      6,    127,    222,    192,
+      82,     54,    181,    238,     99,    228,    195,    207,
+      28,    109,    187,    162,     72,     86,    210,    128,
+     210,     47,     83,     86,    175,    168,     59,    199,
+     196,     95,     43,    154,    231,      3,    172,    115,
+      85,    130,     20,     92,     19,     82,    228,    134,
+      12,    105,     52,    171,    148,    159,    233,     66,
+      29,    220,      3,     56,    182,    128,     52,     67,
+     171,    184,    184,     31,    205,    138,     81,    233,
+     151,    233,    202,    182,     48,    220,    201,     12,
+     179,    175,    247,     38,    190,    212,    225,    239,
+      97,    243,    183,     73,    127,     76,    204,    143,
+     230,    106,    105,      0,    243,     64,     44,    179,
+     161,    211,     22,     68,    185,    232,    127,     85,
+     247,    186,     34,    126,    100,    107,     46,    186,
+     159,     59,     77,    176,    254,    102,    239,    198,
+      36,     48,    104,     67,    133,    213,    112,     96,
+      64,    236,    138,    163,     87,    104,    173,     47,
+      86,    167,    193,    202,     47,     46,    247,     97,
+      22,    181,     18,     12,     16,    237,    185,     60,
+      51,    201,    154,     37,     43,    128,    190,     45,
+     175,    250,    119,    174,    148,     48,    125,     31,
+     223,     66,     82,     53,    228,     13,     86,    225,
+      28,    238,    176,     73,      9,    128,    199,    232,
+     159,    155,      6,     38,    202,    226,    184,    150,
+     174,    225,     43,     31,    198,    169,     26,    198,
+     200,    120,     22,    165,     34,     93,    175,     36,
+     100,    153,     31,    127,     74,     27,     29,    203,
+     191,     87,     85,     43,      2,     32,     31,    216,
+     226,     87,     71,     27,     89,    200,    202,     76,
+     252,    197,    224,     26,     87,    255,    223,     39,
+      61,    215,    216,     69,    253,     25,     49,    181,
+     128,    237,     82,     62,    239,    177,      1,      8,
+     224,    194,    187,     82,    251,    202,     13,    147,
+     155,     30,    113,    205,    174,     68,     30,    146,
+     207,     60,    134,    203,    114,     56,    203,    173,
+     207,    176,     34,     95,     37,    218,    210,      7,
+      34,     47,    196,     23,    112,    232,      4,     10,
+     143,    240,     25,    254,     94,    228,     31,    123,
+     188,    208,     64,     67,     88,     60,      8,     57,
+     237,    220,     95,     79,    251,    238,    230,    147,
+     174,     25,     62,    233,    179,     23,     29,    237,
+     220,      2,     41,    175,    233,    127,    239,    179,
+     235,    162,    167,    243,     16,    198,     29,    249,
+     227,     19,    134,    249,    115,     64,    221,    133,
+     223,     44,    241,     63,     72,    192,     24,    100,
+     205,      2,     31,    200,     99,     82,    242,    226,
+     222,    246,     14,     33,     12,     69,     56,    225,
+     250,     16,     45,     28,    192,      0,     91,     24,
+      17,    247,     41,     58,    243,     27,    216,    250,
+      32,      2,    237,    199,    170,    233,     89,     32,
+     188,    235,      2,    223,      9,      2,    168,    232,
+     100,    236,    180,    185,    140,    242,     87,    105,
+     225,    159,     85,     40,    202,     69,     36,     26,
+       2,    192,     14,     30,     46,      7,     14,     87,
+     249,    130,    227,     99,    217,    169,     14,    230,
+     169,    172,     43,     13,    235,     48,    147,    188,
+      85,    248,    177,    234,     50,     31,    185,    180,
+     243,     59,     76,     46,    249,    153,    223,     38,
+      34,    243,    182,     65,      1,    163,    224,     22,
+      61,    235,     24,     71,     26,    178,    222,    103,
+      61,      7,    173,    196,     43,     81,      1,    145,
+     240,     51,     88,     12,    138,    250,     84,     58,
+      14,     78,     27,    128,    240,    111,    244,    173,
+      36,     30,    187,    195,     69,     25,    128,    189,
+      35,    103,     32,    131,    210,     73,    231,    247,
+      84,    226,    161,      4,     88,    235,    192,     52,
+      87,     11,    198,     80,     34,    201,     64,     18,
+     220,    183,     19,     42,    197,    225,    167,    210,
+      61,     70,     65,     16,    233,    215,    206,     60,
+      67,    223,     11,     88,     21,    205,     40,     52,
+     215,    242,     34,     48,     56,     28,      2,     13,
+      47,    235,     20,     76,    201,    211,    252,     50,
+      51,    164,    171,     32,     91,    221,    190,     11,
+      37,     31,    229,     41,    237,    128,    239,      9,
+      15,     66,    203,    205,    206,    239,     66,    246,
+     236,    181,    220,     40,     17,     51,     17,    197,
+     226,    234,    231,      2,     25,     17,    183,    243,
+       0,    203,     62,     16,    156,    243,     55,     48,
+      15,    246,    241,      0,      3,    185,     13,     98,
+     248,    159,    243,     91,      4,    171,    169,    209,
+      33,     20,    218,    208,    221,    219,     22,     82,
+     242,    149,    243,     62,    200,    193,     11,     71,
+      72,     52,     10,    144,    240,     91,     23,     25,
+      19,    217,    243,    242,      5,     60,     14,    233,
+      37,      6,     59,     32,    219,     64,    234,      0,
+      82,     13,    229,     22,     42,    187,    185,     43,
+      47,    227,     11,     24,    227,     77,    217,    236,
+      68,    156,     23,    110,      8,    179,    227,      6,
+     177,    195,     27,     17,    211,    197,    224,      2,
+      62,     26,    221,     40,    183,    181,     81,     68,
+       5,    202,    255,     53,     59,    240,    192,     57,
+      29,    161,     16,     73,    207,    247,    239,    233,
+      24,    232,    196,    217,     33,     34,    255,      8,
+      27,     24,     27,     12,     29,    255,     17,     78,
+       3,    238,    187,    254,     55,    211,     55,     46,
+     191,    247,    243,    187,     21,     21,     34,     29,
+     211,     85,     29,      7,     24,    163,     39,     77,
+     179,    210,     72,     71,    248,    176,    188,     33,
+      34,    242,    209,    209,      8,     64,    251,    202,
+      30,    212,    216,    231,    223,     65,    252,    178,
+     215,    226,     47,    252,    167,    228,    250,     23,
+      57,    245,     13,     81,    188,    160,     13,    249,
+      39,    110,    204,    202,     75,     35,    233,    223,
+      37,     13,     27,     43,     10,     58,    236,    245,
+     253,    185,    221,      6,     52,    212,    162,    228,
+      61,     50,    207,     64,      1,    195,      9,      4,
+      64,     20,    222,    195,    252,     38,     13,      5,
+     230,    251,      5,    233,     28,     58,     33,    253,
+     203,     46,     51,    222,     15,     65,      8,    149,
+     202,     85,     51,    187,    238,     75,    241,      7,
+      50,      0,     39,    187,    220,     18,    250,     56,
+     207,    215,    225,    216,     65,    223,    176,    219,
+     216,     32,     67,    218,    137,     31,    240,    204,
+      96,    218,    236,    107,    232,    171,     10,     41,
+      26,    254,     23,     53,     35,     33,      8,     31,
+      33,    231,    223,     29,     60,     43,      8,    191,
+     222,     69,      7,    160,    235,     19,    251,     36,
+      14,      3,      1,    253,     35,    237,    227,    235,
+     209,     50,     33,    201,    217,      2,    229,    192,
+      38,     44,    216,    235,    255,     30,     18,    249,
+      12,      0,     13,     24,     42,     23,    164,    227,
+      59,    250,    252,     19,     23,     45,     20,    238,
+     252,      4,    243,    168,    221,     88,    240,    220,
+     236,    216,     50,    216,    214,     19,     48,    237,
+     171,      4,    255,     39,    219,      3,     73,    185,
+     168,     31,     58,    228,    237,      0,    220,      1,
+      15,      0,     13,    253,     19,     11,     33,     36,
+       2,    255,    247,     26,     19,    245,    243,      7,
+      17,     43,    220,    220,     19,    243,     21,    215,
+     228,     51,     19,     15,    241,    211,    254,     27,
+       2,    240,     17,    255,    251,      7,     30,     29,
+     247,     38,    249,    225,     22,     34,    216,    210,
+      41,     21,    230,    221,    240,     54,     55,    171,
+     187,     50,    234,    253,     51,    221,    192,      9,
+      72,    236,    249,    249,    191,      8,     47,     39,
+     235,    205,      9,     29,    232,      3,     49,      3,
+     208,    184,    228,     57,    255,    199,     37,     36,
+     224,    250,     31,    250,    252,      0,    211,    220,
+      15,     28,     11,     29,      2,     34,     33,    241,
+       9,     44,     16,    223,     53,    238,    173,     11,
+      56,    234,    160,     19,     61,     24,    211,    219,
+      68,     46,    204,    175,     32,     63,     23,     12,
+     179,    226,     52,     34,    229,    172,      7,     11,
+     230,    205,    215,     43,    247,    232,     16,     27,
+      15,    222,     43,      1,    152,      4,     34,    233,
+     233,      4,      2,      4,     35,     18,    247,    239,
+     237,     36,     32,    202,    237,     28,     21,     21,
+      48,      2,    174,      0,     44,     24,     28,    252,
+      40,      4,    166,     25,     39,    145,    228,     42,
+     221,     27,     27,    238,    253,     24,     41,    254,
+     219,    247,     46,     29,    246,    213,    231,     20,
+      32,     32,    209,    193,    253,     36,     44,    255,
+     247,     35,    248,    225,      2,    214,      5,     67,
+      28,    190,      5,     44,    182,      6,     62,     12,
+     255,     24,    238,    212,     25,    225,    235,     42,
+      21,     42,    255,     17,     24,    251,    232,    212,
+      10,    248,    216,    249,      8,      5,      5,    249,
+     236,    244,     47,     47,    211,    213,     20,    250,
+     241,      8,     11,    252,      8,     20,    253,    228,
+      25,     32,    181,     15,     17,    191,     19,    245,
+      29,     21,    166,    233,     25,     49,     24,    204,
+     221,     16,      9,    225,    228,    248,     12,    222,
+     229,     46,     20,      0,    206,     22,     69,    210,
+     243,     24,    236,     30,     34,    163,    243,     78,
+     219,    191,    253,     47,     18,      3,     54,     28,
+     242,    244,     11,    244,    245,     38,    231,      6,
+     228,    208,     67,    250,    212,      2,     38,      7,
+     231,     17,     37,    243,    248,     32,    220,    227,
+      39,     18,     14,    249,    240,     18,    255,     38,
+     235,    163,     20,     67,     37,    254,    219,    238,
+      16,     15,      5,      1,    249,    248,      7,     13,
+      32,     23,    238,     23,     28,      0,     18,     19,
+     251,    249,     10,    230,    228,    235,    254,     50,
+     215,    159,      5,     40,     29,     21,    226,    214,
+     249,     15,     20,     11,    239,    219,      3,      2,
+     200,    248,     27,    238,    250,     21,      8,      3,
+     243,    210,    235,     13,     39,     14,      6,     42,
+       6,    196,    223,     33,     19,    250,    249,    244,
+     248,      3,     12,     32,     22,    224,    173,    247,
+      55,    245,    250,     18,    207,    228,     38,    252,
+     210,      0,    249,      3,     20,    232,     34,    232,
+     209,     24,      9,     36,    247,    208,     30,     34,
+     228,    197,    245,     11,    238,     23,    228,      0,
+      68,    247,    229,    228,     27,     34,    234,      4,
+     228,     11,     50,    233,    216,     23,     44,     29,
+     226,    170,     12,     59,     17,    237,     17,     54,
+     233,    218,    248,     34,     13,    237,      7,    248,
+      14,      3,     28,     17,    233,     17,     10,     11,
+       4,    252,    219,    237,     36,    218,    253,     20,
+     231,     36,     19,     14,     43,    225,    246,     34,
+      11,    243,    206,     20,     32,     13,      7,    200,
+     220,     28,     14,    221,    251,    232,    244,     32,
+     244,     14,    220,    212,     45,     29,     26,    244,
+     245,    223,    231,     16,      2,     35,    215,    234,
+      43,     32,    253,    221,     16,      9,      8,    253,
+     242,      9,     17,     34,    213,    196,     28,     37,
+      26,    220,    154,    226,     10,     34,     21,    248,
+     229,    195,    235,    238,     24,     29,    221,    226,
+      12,     57,     24,    182,    174,     30,     57,      3,
+      13,      9,    230,    251,      2,    243,    245,      8,
+      17,    205,    240,    254,    250,     23,    250,      4,
+      33,      7,    207,     34,     38,    240,      1,    231,
+     242,     27,     27,     21,      9,    251,    248,     12,
+      25,     11,    249,    241,      4,     33,     33,    233,
+     215,     22,     53,    221,    225,     17,    237,     10,
+      52,     27,    253,      2,    218,    235,     44,    236,
+     235,     53,    244,    228,     51,     22,    200,    225,
+      24,      4,      3,      0,    228,     18,     31,    224,
+       5,     23,    181,    231,     65,     33,      6,      2,
+     205,    205,     29,     20,    234,    233,      4,     28,
+       4,    242,      4,    255,    247,    227,    241,      4,
+     233,     21,     36,    235,    224,      7,    245,    242,
+      41,     15,    202,    215,     23,     32,    244,    215,
+     236,     34,     12,    193,      6,     40,    231,    238,
+     242,    252,    244,    231,      5,     37,     13,    248,
+      10,     12,    243,    232,      2,     15,     15,    238,
+     223,     20,     36,     25,    255,    232,     12,     10,
+     242,    241,     19,     38,    249,    252,     29,    236,
+     241,     27,     37,     19,    246,      6,    236,    216,
+      12,     18,    234,     12,    249,    245,     17,     13,
+      11,    238,    225,    241,     46,     14,    181,    207,
+      60,     33,    212,    237,     15,     45,    245,    215,
+       4,     41,     12,    212,     30,     32,    243,    246,
+     227,     29,     22,    243,     16,    252,     20,      5,
+     249,      3,    233,     16,     23,    247,      7,     15,
+     203,    219,     41,     30,    199,    206,     31,     20,
+     252,     15,     25,    240,    253,     30,     17,    235,
+     251,     30,    240,    247,      6,    245,    253,    234,
+     252,     28,    240,    225,     10,    246,    235,     26,
+       8,    202,    230,      6,     29,      1,    219,    217,
+     234,     55,    233,    198,     10,     22,     28,      1,
+     221,      5,     10,    236,     32,     15,    254,    246,
+     236,     22,     14,    247,    252,     12,      3,    237,
+     250,      3,     19,     20,      3,    255,      8,     29,
+     202,    230,     52,    225,    232,     17,     18,    254,
+      12,     30,    237,    252,    210,      9,     33,    197,
+      15,      0,    196,      9,     46,    248,    242,     23,
+      31,      4,    217,      4,     26,    222,    242,     38,
+     249,    227,      0,      7,      7,      2,      4,      4,
+       4,      1,      8,     26,    234,    248,     32,    225,
+     236,    244,      8,     21,    209,    245,     24,     17,
+     232,    228,     40,    246,    243,     43,    230,    203,
+      43,     26,    222,     20,      3,     13,     29,    224,
+     242,     13,     17,    233,    233,     22,    249,      7,
+      13,    238,    247,     20,     25,     23,    251,    197,
+      19,     46,    223,    211,     21,     33,    253,      2,
+     234,    242,     15,     34,    207,    196,     33,     21,
+       1,    237,    241,     18,      0,      8,     26,     17,
+       6,    241,     10,     17,    235,    246,     24,    236,
+     242,     17,     11,    233,    219,     48,    248,    232,
+       6,    237,     16,    234,    253,      5,    231,     34,
+     239,    227,     20,    208,    245,     30,    228,    251,
+      10,    228,    236,     17,    240,    224,     31,      1,
+     199,    225,     40,     35,    246,      2,      9,     20,
+       6,    249,     12,     13,    254,    235,    243,     15,
+       4,    239,     20,    255,    236,     14,    246,    254,
+      18,     15,     18,      1,    252,     10,     10,    253,
+       6,     14,    235,      4,      8,    199,    240,     49,
+     243,    245,     30,    234,     12,     14,    245,      4,
+       9,     27,    247,    253,     39,      1,    236,     14,
+       6,      0,    241,    244,     39,      4,    247,     14,
+       7,      5,    252,    242,    249,     24,      4,    228,
+       9,     16,    255,     20,    235,    230,     21,     12,
+     232,    234,     15,      7,      9,      2,    254,      8,
+     234,    220,     16,     25,    222,    250,     19,      1,
+     255,    233,      2,    250,      5,     36,    221,    207,
+      21,     20,    227,      0,      3,    250,    254,    255,
+      25,    254,    236,      2,     10,      8,    220,    244,
+      24,    195,    236,     54,     11,    217,    202,      1,
+      27,    255,    239,    245,    252,     12,      1,    251,
+      10,    243,    244,     13,    251,    252,      3,      3,
+      12,    223,    254,     25,      9,     15,    238,    242,
+     238,      9,     24,     11,     11,    227,    255,     31,
+     250,    243,     22,     30,    251,    230,    254,      7,
+      10,     26,      9,    249,      9,    248,    247,      7,
+      11,    255,      5,     22,    255,     19,      3,    247,
+       6,    253,      0,      6,     30,    232,    237,     32,
+     224,    222,    248,      0,     20,      1,    254,      0,
+     245,    248,      9,      9,    250,    250,    234,      0,
+      11,    245,     11,    231,    238,     31,     20,    255,
+     243,    245,      1,      5,     10,      4,    222,    240,
+      25,    249,    228,     23,      2,    252,      3,    217,
+      13,     26,    251,    255,    255,    255,    251,    239,
+      20,     15,    214,    233,     14,     15,    247,    241,
+       7,     11,    232,    246,     13,      9,    253,    237,
+      14,     22,    251,      8,     18,    215,    233,     28,
+      27,      7,    222,    248,      4,     18,     20,    236,
+      11,     10,    238,    255,     15,     11,    245,    222,
+     249,     30,    232,    229,    245,      2,     32,    243,
+       5,      8,    241,     11,     16,    249,    224,      0,
+      34,     18,    225,    221,      4,     14,     27,    255,
+     231,    253,     29,     12,    235,      9,    249,    250,
+      27,    247,    233,     23,     10,    228,    238,    253,
+     255,    250,     25,      9,    241,      9,      1,      1,
+     251,      1,     20,      6,    247,    246,      8,      3,
+     251,      2,      7,    250,      2,     21,    224,    224,
+      14,      3,    228,    255,      5,    254,    252,    222,
+       9,     21,      8,    243,    230,      4,     17,    252,
+       4,      1,    238,     20,      7,    239,    238,      4,
+      22,      2,    246,    250,     14,     15,    248,    255,
+     252,    246,     10,      6,      5,      7,    254,    212,
+     251,     18,    254,     19,    226,    255,     10,    240,
+      17,    248,    234,    254,      8,      1,      7,      5,
+       9,      8,    236,     25,     20,     10,      2,    205,
+      10,     19,    239,      6,     10,      5,    239,    237,
+      19,     21,    255,    251,     13,    250,    230,     20,
+      17,    247,    248,    238,     10,     16,    251,    246,
+     246,      2,    245,     13,      6,    238,      1,    251,
+      11,    251,      7,     15,    233,    253,      0,     15,
+     249,    231,     19,      6,    249,      5,    242,    255,
+      24,    245,    253,      8,    236,    253,     15,    244,
+     207,    253,     34,      9,     15,    255,    244,      7,
+     253,    247,     23,     13,    242,    252,      7,     19,
+     250,      0,     15,    248,    247,    254,     15,    254,
+     238,     15,      6,    250,    254,    247,     16,    254,
+     219,    252,     18,      0,      0,      1,    252,      3,
+      18,      6,    225,    234,     24,     12,    234,    253,
+     237,      0,     15,    243,      9,    254,     10,      7,
+     244,     10,    247,    254,      5,      6,      7,    247,
+       9,      3,    209,    215,     20,     18,    249,    230,
+     237,     22,      9,    235,    238,      3,     18,    247,
+     243,      3,     10,    255,    238,    240,    247,     17,
+       4,    232,      3,      8,    245,      3,     22,    254,
+     250,     13,    253,      1,    255,     20,    243,    210,
+      12,      4,     16,     18,    212,    236,     21,     26,
+     255,    219,      4,     12,    253,      8,     14,      4,
+     235,     16,     14,    241,      7,     15,      6,      0,
+      13,     11,     18,     17,    236,    255,     13,    238,
+     254,     16,    254,      6,     14,    251,    249,      8,
+      11,      4,    255,      6,    255,      1,     16,    250,
+     251,      5,    254,    251,    247,     12,     17,    236,
+     216,    250,     21,      6,    241,    243,     11,     14,
+     237,    249,     25,    233,    243,     18,    253,    244,
+     253,      4,    249,    253,    245,    253,     12,    255,
+     242,    250,      6,    234,    240,     18,      6,    253,
+       0,    254,      1,    243,    254,     13,    243,    241,
+       0,      7,    254,    249,    252,    247,      3,      2,
+       4,      6,    247,    250,    239,    236,      1,     20,
+      18,    240,    248,      3,    244,      1,     13,     15,
+     247,    227,      2,    252,    248,     15,    252,    244,
+       5,      7,      4,    252,    252,    253,      3,      8,
+       8,      9,     17,      5,    218,    243,      8,     12,
+      13,    234,      0,      8,      0,     11,      1,      8,
+      10,      1,      6,      6,      0,     10,      6,    255,
+     251,    254,     18,      6,    247,    248,    239,    255,
+      20,    248,    233,     20,      7,    236,     13,     10,
+     255,      1,      0,      8,    244,    239,     12,     12,
+       0,    239,      8,     12,    247,     10,      1,    252,
+     233,      7,     27,    223,    248,     22,      0,    237,
+     229,      0,      9,    254,    252,    254,      1,      5,
+     255,    250,      1,      3,    251,    252,      6,      6,
+       1,    251,    249,    255,      2,    252,    245,    253,
+       5,    253,    251,      5,      1,    250,    249,      1,
+       7,      6,      7,    248,    237,    253,    254,    255,
+      10,    244,    247,    248,    238,     14,      7,    232,
+     254,     20,    251,    229,    251,     16,      5,    244,
+     244,     10,     17,    255,    240,      3,      5,    251,
+       8,     13,      6,      6,    253,    224,      1,     20,
+       3,    248,    247,      9,      5,      1,      0,    253,
+       7,      7,    247,     10,     17,    246,      1,     12,
+     252,    248,      6,      9,      2,    254,      6,      4,
+     250,    250,    245,     10,      5,    234,      5,     11,
+       0,      0,    251,      3,      0,    253,      7,      7,
+       6,    236,    241,     20,     10,    245,    242,    254,
+       8,      5,    247,    253,      9,    252,    253,      0,
+     239,      3,     11,      0,    250,    245,     10,      3,
+       1,      4,    246,    249,    251,      3,      5,      0,
+     255,    243,      1,      6,    244,    255,      2,    243,
+     255,    254,    248,     12,    255,    240,      4,      4,
+       4,    255,    250,    249,    252,      8,    246,    241,
+       0,     11,      2,    247,      0,    252,      0,      6,
+       8,    253,    246,      9,     14,     13,      8,    245,
+     254,      6,    255,      6,      5,      0,    252,    248,
+       6,    255,    254,     11,    249,      4,     11,    254,
+       4,      4,      3,    251,    254,      5,      3,      1,
+       6,    248,    231,      1,     18,      0,      0,    248,
+     233,      6,     14,     10,      0,    238,      0,      3,
+     242,      0,      6,    244,      4,      7,    245,    255,
+     252,    249,      6,    248,    247,      4,      0,    248,
+     252,      5,    247,    243,      5,     11,    246,    252,
+      11,    240,    246,     12,      2,    247,    253,      4,
+     253,      6,      9,    250,    254,      8,      2,      0,
+      10,    253,    237,      1,      6,    252,      9,      4,
+     254,    250,    243,    255,      7,      9,      6,    248,
+     242,    251,    252,      5,      4,    249,    253,      1,
+       7,      4,      0,     10,    255,    252,     12,      2,
+     247,      8,      3,    244,    248,    255,      5,      1,
+       5,    252,    246,      5,    255,    252,      7,    255,
+       5,    255,    229,    250,     16,      6,    250,    251,
+       6,      2,    251,      3,    244,    239,      2,      8,
+       6,    251,    254,    251,    247,      1,      4,      8,
+       4,    253,    250,    254,    254,    252,      1,      0,
+       0,      1,      0,      2,    253,      1,      1,    253,
+       3,      0,      7,      3,    247,    255,      3,    254,
+       2,    250,    253,      4,    244,      3,      7,      6,
+       1,    245,      3,      8,      5,      4,    249,    244,
+       7,      2,    252,      5,      1,    252,      4,    254,
+     253,      0,      1,     11,    248,    238,    251,      5,
+       1,    246,      8,    255,    240,      3,      6,    249,
+     251,      1,      5,      3,    254,      3,    252,      1,
+       4,    254,      7,      0,    245,      4,    255,      0,
+      15,    244,    250,      8,    243,      3,      7,    251,
+     253,      2,      1,    253,    252,      0,      5,    249,
+     253,    250,    249,    253,    247,     12,      2,    250,
+       7,    246,    244,      3,      9,      0,    250,      5,
+       3,    254,      1,      6,    248,    249,    255,    249,
+       6,    251,      0,      5,    241,    248,     11,      5,
+     247,    249,    254,      8,    255,    245,    253,    252,
+     250,      4,      7,      1,    253,    253,    251,      0,
+       7,      4,      5,      2,    247,    255,      8,      3,
+       5,      3,    250,      1,      6,      0,    253,    253,
+       0,      2,      1,    252,    255,      6,      5,    248,
+       0,      9,    254,    253,    255,      2,    255,    254,
+     254,    252,      5,    254,    252,      6,      1,      0,
+     251,    254,      3,      0,      4,      1,    255,    254,
+     253,      1,      5,      1,    253,      2,      0,      3,
+       0,    243,      4,      1,    248,      3,    247,    251,
+     255,    254,      4,      0,      0,    252,    250,      1,
+       3,    255,    253,      0,      4,      3,    252,    252,
+     253,      0,      3,      4,      1,    252,      4,    253,
+     250,      0,      1,      6,    252,    246,      1,      3,
+     252,    251,    255,      0,    253,    253,      2,      1,
+     246,    252,     10,      6,    242,    247,     11,    255,
+     248,    248,      2,     11,    255,    252,      0,      3,
+       0,      0,      2,    254,      3,      0,    251,      3,
+     254,    253,    253,    254,      5,      2,    252,    252,
+     251,    248,      3,      7,      2,    246,    249,      8,
+     255,    251,    255,      4,    255,    253,      4,    250,
+     255,      5,      1,      6,    252,    251,      6,      0,
+     254,    249,    255,      6,      2,      4,    253,    252,
+     247,    253,      8,    255,    254,    255,      1,      0,
+       0,      0,    251,      0,      6,      2,    251,    249,
+       3,      1,    252,    251,    255,      7,    251,    251,
+     254,      2,      5,      0,      6,      0,    255,      4,
+       2,    248,    248,      6,      6,    247,    253,      1,
+     254,      0,    247,    253,      2,      1,    253,    253,
+       5,    253,      3,      2,    253,      3,      1,      7,
+     252,    247,      1,    255,      2,      1,    255,      1,
+     254,    252,      2,      3,    255,      5,    255,    251,
+       1,    254,      0,      1,      0,      0,      2,      3,
+     255,    251,      0,      1,      1,      2,    252,      0,
+       0,    254,    253,    250,      2,      2,    251,      1,
+       2,    252,      2,    255,    254,      3,      0,      3,
+     254,    251,      5,      1,    251,    251,      1,      8,
+     248,    246,      7,    253,    247,      3,    255,    248,
+     254,      2,      4,    253,    246,    255,      6,    255,
+     252,      1,      3,    254,    254,      1,    251,    246,
+     251,      3,      5,      4,    255,    252,    255,    254,
+       5,      2,    250,      1,      3,      1,    254,    248,
+     254,      2,      0,    255,      0,      0,      5,    254,
+     245,      5,      4,    253,      2,      3,      3,    254,
+     252,      0,      0,      3,    254,    250,      0,      2,
+       2,      2,    251,    250,      1,      3,      5,    255,
+     255,      1,    253,      2,      6,      0,    249,    252,
+       2,      1,    253,    252,      1,      0,      0,      3,
+       0,    255,    252,    253,      4,      1,    251,    253,
+       2,      1,      4,    253,    246,    248,    250,      6,
+       3,    248,    255,      4,      1,    254,    254,    253,
+     253,      0,      1,      0,    251,    254,      0,    255,
+       3,    252,    252,      5,      0,    250,    255,      0,
+     249,    255,      5,    255,    254,      0,    254,      1,
+       5,      0,    251,      0,      4,      2,      3,    255,
+     246,    252,      5,    254,    251,      0,    251,    255,
+       3,      2,      2,    253,    254,      4,      1,    255,
+     253,    252,      5,      4,    251,      4,      1,    253,
+     253,    255,      7,    252,    252,      0,      0,      3,
+     252,    255,      2,    255,      0,      3,      4,    253,
+     249,      2,      2,    254,    254,    251,      3,      2,
+     251,      2,    255,      0,      3,    253,      3,      3,
+     251,    255,      3,    254,    251,    252,    255,      2,
+       0,    251,    252,    255,      1,      0,    255,    254,
+     254,      0,    255,      1,      0,    255,    251,    249,
+       3,      1,    252,      2,      1,    254,    252,    249,
+       1,      1,    251,      1,      2,    252,      0,    254,
+     254,      3,      2,      0,    253,    253,      1,    252,
+     248,    254,    254,    253,      5,      3,    252,    255,
+       4,      2,    254,      4,      0,    251,      4,      4,
+     255,    251,    251,      1,      5,      1,    253,    254,
+     252,      2,      5,    253,    247,    254,      3,      3,
+       1,    253,    252,      3,      0,    254,      0,    254,
+       0,      3,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,    254,      0,
+       0,      0,      2,      0,      0,      1,    255,      0,
+       3,      5,    252,    252,      0,      0,    255,    255,
+       0,      0,      0,    254,    253,      0,    254,    255,
+       3,    255,    255,      0,      0,      0,      0,      0,
+     255,      0,      0,      0,    255,      0,    255,    254,
+     255,      1,      0,    253,      0,      1,      0,      0,
+       0,      0,    254,      0,      2,    254,    252,      0,
+       2,      0,    254,    254,      0,      1,    255,    255,
+       0,    255,      0,      1,      1,    255,    254,      0,
+       1,      1,      0,    255,    254,      0,      2,      0,
+       1,    255,    252,    255,      2,      2,    252,    250,
+       2,      3,      0,      1,    254,    254,      1,      0,
+       0,      0,      0,      0,      0,    255,      0,      0,
+     255,      0,      1,      0,    255,    255,      1,      0,
+       0,      0,      0,      0,      0,      0,      0,    255,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      1,      0,    255,      1,      0,
+     255,    255,      0,      0,      0,    255,      0,      0,
+       0,      0,    255,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,    255,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+};
+#endif  // NUM_HH_SAMPLES > 0
+
+#if NUM_HH_SAMPLES > 1
+static const prog_uint8_t hh_sample_linn[] PROGMEM = {
+       4,    251,    116,     27,     13,     41,    158,    245,
+       7,    208,    236,     18,    233,    240,    248,    226,
+       0,      0,     43,    236,    188,    245,     13,    237,
+     199,    237,    163,    199,     39,    240,    246,    248,
+     251,      7,    223,      3,     23,    250,     31,     18,
+      11,    237,    199,     48,    253,    224,    234,     26,
+      35,    250,     60,    198,    220,     14,     13,     63,
+     254,    227,    235,    254,     27,     10,    181,      3,
+      88,    245,     22,     57,     83,     16,    240,     16,
+      16,     19,     13,     69,     14,    231,    242,      9,
+     249,    227,     18,     12,    217,    232,     38,    206,
+       9,     69,    216,    227,    223,     16,    217,    215,
+       7,    200,    189,    190,    202,    243,    252,    231,
+      19,    199,    207,    246,    246,     44,      1,    201,
+     205,     26,    249,    211,    228,     26,      7,    224,
+      31,      1,    211,    244,     64,     60,    246,    240,
+      54,     88,     22,    246,      4,      6,     21,     10,
+       2,    232,     13,     24,     47,     48,    225,     86,
+     244,    244,     53,     16,    249,    209,     64,     43,
+     220,    156,    225,     79,      3,    203,    251,    239,
+     199,     64,     10,    172,      5,    228,    147,    161,
+     244,    231,    219,    189,    227,    239,    128,    206,
+     209,    182,    228,    236,     19,    215,     14,     27,
+      29,     16,      3,    244,    252,     67,      3,     58,
+     253,     70,    246,    224,     82,    200,     33,     54,
+      16,    249,    219,     30,      4,    218,    223,    241,
+      87,    237,    208,     18,     16,     81,     23,     12,
+     217,    211,      5,    212,    244,    173,    215,     71,
+     210,    229,    242,    174,      7,     78,    234,    164,
+     184,    251,     72,    218,    209,     46,      7,    246,
+      10,    226,    164,     16,     23,    189,    232,     26,
+      24,    235,     32,      2,     27,     47,    181,     31,
+      58,    244,    243,    214,     74,     53,    164,    244,
+      23,     73,     14,    244,     41,    253,      4,    152,
+     206,     45,    240,    216,    176,    201,    248,     19,
+      21,    195,    253,     50,    234,    251,    254,    214,
+     227,    231,    251,    225,    164,    152,    248,     32,
+      30,     27,    207,    241,    239,     27,     24,     41,
+      90,     18,     23,      3,    218,    239,     86,      4,
+     216,    201,    186,     64,    236,    220,     16,    219,
+     251,     71,    205,    135,    167,     19,    108,    215,
+     237,    249,    168,     61,     86,    217,    219,    252,
+      74,     14,    182,     37,     52,    253,    229,    212,
+     216,    220,      1,     10,    237,    227,    241,      3,
+     249,    217,     12,     46,    252,    243,    223,    229,
+     216,    250,     24,    195,    195,    223,     41,     14,
+     197,     39,    242,      6,     33,    211,     19,     14,
+       0,     13,    232,    215,    242,    253,     60,    228,
+     186,     24,     61,     20,    183,    182,    243,      4,
+     251,    233,    235,     20,    233,     11,     26,    246,
+     183,    240,     18,    227,     96,    228,    152,     87,
+      70,    205,    219,    216,      2,     15,    228,    225,
+       2,     23,    226,    253,     26,    232,    195,     37,
+      28,      6,    240,    225,     35,     22,     12,    228,
+     214,    245,    246,    210,      4,    235,    212,     37,
+     248,    236,     15,    248,    243,      4,    253,      1,
+      14,    249,    248,     55,     11,    195,    233,      5,
+     245,    206,    248,    251,    226,    248,    240,    223,
+       5,    229,     11,     20,    194,    243,    252,    246,
+     201,     61,     55,    222,      9,    151,    210,     35,
+     218,    237,    231,      3,     33,    232,    218,    240,
+      37,    252,    250,     86,    228,    158,     13,     20,
+     250,    198,      9,     70,    223,      4,     21,    235,
+      24,    244,    176,     35,     33,    228,    248,      4,
+     234,    232,     16,    223,    251,     28,      1,     27,
+     231,    212,     13,     11,    214,    202,     61,      9,
+     167,    202,    233,    209,     11,     19,    206,    203,
+     200,    240,     21,      1,    229,     62,      9,    225,
+     254,    239,    202,      9,     74,    216,    185,    201,
+      40,    222,      0,     98,    233,    216,     23,     27,
+     242,     11,     21,     16,      1,    193,     10,     78,
+      15,    249,    231,      5,     11,    214,    240,      5,
+     224,      3,    240,    233,    244,    195,    200,     41,
+     240,    194,    239,    224,     83,    245,    161,    233,
+       5,     14,    253,    220,    232,     20,     60,     15,
+     146,    203,    243,     19,    231,    220,     28,    254,
+      12,     73,     23,    177,      7,     26,     23,     54,
+       3,    206,    236,    254,    254,    219,    191,     16,
+      18,    218,      1,    228,    206,     27,    243,    210,
+     203,    227,      5,    228,    226,    252,    227,    254,
+      19,    214,    241,    248,     36,     46,    207,    220,
+      20,    220,    190,     11,    248,    240,     50,     60,
+     202,    223,    243,    245,     21,    229,     57,     29,
+      15,     38,      4,      9,    251,    233,     10,    248,
+     190,    241,     32,      4,    200,    236,    220,      0,
+      90,    245,    156,    217,     30,     13,    209,    200,
+     220,    248,     54,      9,    201,    193,     26,     52,
+     220,    183,    218,      4,      7,    243,    216,    232,
+     245,     46,      4,    214,     29,     29,      0,     66,
+      30,    214,    227,     20,     46,    237,    229,     48,
+      40,    229,    252,    211,    237,    240,    251,     39,
+     205,    203,    220,      7,    232,    191,     13,      9,
+     215,    253,    244,    220,     27,    250,      6,      4,
+     217,      0,    253,     37,    241,    212,      3,     18,
+      33,    211,    167,      0,     37,    248,    240,    249,
+      10,     46,     31,    239,    248,    226,    246,    248,
+     227,     28,    235,    232,    250,    240,     15,    231,
+     243,    245,      2,     11,    192,    212,     26,    217,
+     235,     22,    191,     32,      6,    178,     16,     45,
+      19,    232,    242,    226,    236,      0,    192,     33,
+      77,    214,    237,    252,    229,    254,    215,    243,
+      37,    250,    239,      9,     52,     12,    218,    242,
+       9,     23,     39,    208,    234,     29,    200,    253,
+       9,    237,    224,     46,      6,    215,     31,    251,
+      35,    214,    224,    244,    169,    231,     26,     19,
+     239,    241,    227,     15,     16,    219,    240,    253,
+       4,    228,     16,     21,    177,      5,     31,    215,
+     246,    231,    246,     43,    251,    235,      2,      0,
+      20,     31,     23,     58,    246,    207,     62,    228,
+     226,      5,    218,     22,    232,    234,    223,    245,
+      53,    241,    212,    254,    220,    216,    241,    233,
+      16,    228,    197,    253,     38,    227,    231,     19,
+      28,     26,    209,    243,     32,    246,    225,    241,
+       6,     11,    249,    254,    228,     27,      3,    211,
+       1,    245,     26,      3,     11,    214,    217,     50,
+     245,    237,     53,     21,    237,     19,    233,    246,
+     232,    210,     13,    253,    229,    234,    245,    232,
+     233,    245,     20,    227,    245,     12,    241,      2,
+     228,    242,     45,     10,    254,     26,    216,    248,
+      26,     13,    233,    186,    251,    248,    244,    242,
+     201,     16,    254,      7,    245,    192,    228,      4,
+      19,    222,     21,     21,     19,      1,    235,     74,
+     215,    215,     66,    242,    228,     23,    242,    254,
+     249,    242,    234,    234,     38,    240,    254,     49,
+     224,    246,      0,    242,    216,    212,     67,    228,
+     210,     67,     21,    234,    253,    236,    222,     32,
+     248,    194,     48,    246,    207,     22,    249,    194,
+     199,     44,     36,    249,     18,    220,    244,     57,
+     227,     18,    243,    227,     71,    205,    249,     13,
+     193,    186,    210,     26,    251,     16,    249,    254,
+      41,    205,    217,     56,      5,    211,    249,      3,
+       0,    232,     24,    237,    237,     31,    244,     24,
+      18,     10,    245,     46,    252,    194,    252,    220,
+     250,     10,     18,    245,    228,      3,     30,    249,
+     215,     19,     31,     12,    182,    231,    248,    239,
+       4,    215,     19,     10,    220,     18,     39,    236,
+     241,     19,     14,    226,      7,     29,     14,      2,
+     197,    244,    237,    237,      5,      7,     66,     10,
+      11,    239,    232,     56,    237,    244,     20,    235,
+     205,    244,      1,    233,      2,    205,    209,     23,
+       4,     16,     64,     19,      7,    235,    246,    236,
+     208,      7,    220,      5,    237,    210,     28,    253,
+       5,     14,    231,     31,     21,     12,     53,    219,
+     223,      0,     10,    243,    228,     28,      6,    236,
+     250,      7,    231,    216,     30,     50,    248,    235,
+     198,     16,     45,    210,    236,    232,    225,    254,
+       9,    245,     26,     52,    227,    227,     44,     13,
+     233,      7,     24,    245,    240,    237,    203,      1,
+      14,    207,    237,     18,     33,     33,    251,    249,
+     252,      0,    243,    241,     32,    225,      2,     24,
+     217,    225,    240,      2,     22,     32,    251,      6,
+     249,     14,    252,    243,    253,      6,     14,      2,
+      22,    240,      9,    248,    240,    225,    236,     27,
+     248,      2,      4,    229,      1,      5,    208,    243,
+     245,    214,    220,    224,      5,      2,    227,    240,
+     245,     16,      7,     14,     20,     21,     52,    248,
+     216,    250,    253,    237,     32,     26,      3,     11,
+     218,    236,     15,     18,     28,     26,     21,      7,
+     250,      3,     24,    245,    209,    242,     20,    244,
+     236,    239,      4,    254,    222,    214,    211,     16,
+      27,     15,    239,    254,      2,    216,    243,      0,
+     246,     21,    251,    216,     29,     35,     10,    250,
+      15,     20,    216,    237,      3,    242,    251,     30,
+     245,    218,    234,      1,     24,      5,      3,     10,
+      29,    239,      6,     45,    242,     19,     35,    252,
+     223,      9,    253,    253,      5,    226,      6,     10,
+      18,    244,    235,     26,      0,    242,      1,    226,
+       1,     33,    248,    228,    236,    231,    233,      5,
+      22,    246,     15,    243,    235,      2,    243,    244,
+     203,      7,      5,    234,    222,    249,     41,     22,
+       3,    249,      2,    249,     31,     12,      6,     54,
+      29,    252,    239,     18,    253,    194,    248,     40,
+     246,    239,    244,     10,     20,    237,    248,     11,
+      14,     11,      7,    220,    240,      3,    231,      9,
+     249,      6,    244,      1,      5,    212,     11,      2,
+      10,     19,    232,    242,    232,    235,     38,    227,
+     231,     33,    248,     21,     21,    235,      4,     39,
+     252,    253,      9,      1,      6,    249,      6,    227,
+       4,      2,    236,    250,    227,    253,     10,    239,
+     248,     20,      6,      6,      7,    244,    239,    250,
+      14,    254,      7,     13,    218,    244,      2,    239,
+      10,     11,      2,    251,    218,    223,    253,     14,
+      13,    237,     28,     10,    233,     19,      0,    251,
+       7,     43,     10,      7,    245,    251,     10,    246,
+      24,    234,    234,     18,      7,    237,      4,      3,
+       3,      4,     31,    252,    236,     16,    222,     14,
+     245,    240,     15,    236,    246,    224,      3,      9,
+     235,     18,    246,    224,      1,     11,      1,    231,
+      13,     20,    252,      2,      3,     14,      4,    242,
+      14,     43,      5,    222,      1,     36,      6,    227,
+     216,     21,     35,      0,    236,    233,    253,    252,
+       6,    249,    249,     35,     16,      9,      2,    232,
+       3,     13,    246,    251,      5,    222,    252,     33,
+     248,    232,    243,     19,     10,      1,    226,    250,
+      19,    236,    246,    236,    250,    251,    237,    244,
+     253,     32,     23,    236,     19,     27,    250,    244,
+     234,     16,     57,      4,    235,      7,    252,    250,
+      16,     13,     19,     15,      3,      1,    245,     27,
+     245,      0,    253,    220,      6,    244,    252,    242,
+     254,    250,    251,    250,    233,     20,     19,    232,
+       6,      7,    205,    242,      9,      1,     11,    251,
+     233,     20,     16,    251,      6,      5,    251,      3,
+      22,    216,    251,     55,    250,    248,    243,    245,
+      15,      3,     16,     16,      7,      0,     19,    252,
+     245,     22,      3,     30,      4,     12,    251,    225,
+       5,    252,    250,    223,      9,      7,    253,     13,
+     236,    249,    250,    227,      2,     11,      5,    245,
+     233,     18,    244,    234,    239,     15,     39,    232,
+     249,      3,    250,     22,      3,    239,      1,    254,
+       2,      6,      6,      9,     12,      4,    246,      9,
+       9,      2,     20,     18,      3,      5,     20,     12,
+     243,      3,    232,      6,     12,      1,     23,    254,
+       4,    253,    243,    240,    249,    250,     24,    250,
+     237,    235,    224,      9,    249,    254,    253,    249,
+      11,     20,    250,    235,      6,      3,    248,     23,
+       4,    224,    252,     32,     15,    232,    240,      0,
+      31,     27,      6,    250,      4,      7,     13,      2,
+     226,     10,     26,      2,    251,     18,    248,    242,
+     239,    240,      3,    246,    245,     21,     20,      5,
+     243,    243,     21,    243,    233,    242,     27,     27,
+     253,    252,    250,      3,    246,      0,     11,     18,
+       3,      5,      9,      1,    229,    236,    241,    249,
+       5,    253,     14,    243,     23,    251,    243,     29,
+       0,     18,    251,    252,      6,    251,     11,    244,
+     252,     10,      5,     29,    244,      5,     18,    253,
+      28,    241,    228,    253,      1,     28,     15,    246,
+       0,    244,    246,      4,    237,    239,     26,      4,
+       7,    254,    228,      0,      3,      4,    223,    240,
+      12,     23,     31,    249,    226,    244,     14,      4,
+       9,      5,     27,     24,      0,    241,    235,    252,
+     250,     16,     14,      0,    254,      7,      6,    250,
+       3,    245,     10,      2,    240,    254,     10,     16,
+       0,    235,    217,     19,     18,    237,     16,      9,
+     252,     12,    243,    235,      5,    244,     12,     27,
+       5,      3,     12,      4,    249,    251,    242,      9,
+       5,     12,     19,    240,      6,    251,    246,    252,
+     234,     11,      4,      3,      1,    251,      5,    235,
+     254,      7,    250,      4,      2,    252,     33,     26,
+     232,    254,      4,    249,     18,     20,      0,      3,
+      11,      9,     11,    248,    239,      3,    253,    253,
+       0,    240,    253,     12,    243,    225,      5,     33,
+       0,      9,     24,    240,      3,    245,    232,      2,
+     251,      4,     18,     14,    254,     12,    241,    251,
+       9,    229,     10,     22,     10,      5,     20,      1,
+     254,     13,    253,    248,     15,     23,      2,    241,
+     225,      4,    239,    235,    240,    248,     16,    254,
+       4,     18,      4,    223,    251,      0,    249,     31,
+       6,      4,     21,    244,    244,      9,      6,    252,
+      29,     16,    249,      4,    229,    254,     13,    248,
+       7,      6,    248,     20,     21,    242,    228,    250,
+     252,      3,     12,      3,      1,      2,     24,    249,
+     243,    245,    253,     10,      5,    252,    248,     21,
+     254,      1,      3,    249,    252,      7,     22,     12,
+       5,    252,    249,      1,    243,    236,    244,      1,
+      44,     10,    233,      2,     13,     14,    252,    244,
+     248,     19,     27,    249,    248,     11,    248,    246,
+      23,     15,      2,      1,      9,      2,    246,    237,
+     242,     19,    254,    228,     21,     21,      3,    239,
+     231,      6,     10,      5,    248,    243,     10,     23,
+     253,      9,    248,    241,     13,      1,     16,    248,
+     244,     13,    250,     12,      5,    248,      7,     10,
+      30,     26,      5,      3,      3,    254,    246,    245,
+       5,     20,    254,     22,      5,    232,    252,      3,
+       5,    239,    249,    237,    253,     12,    229,    226,
+     240,     21,     16,    248,    246,      2,     14,      6,
+       3,      2,    235,      1,     32,     11,      4,    248,
+       3,     26,      5,    237,      3,     31,     11,    243,
+       5,     21,     13,      4,    244,    248,      2,    253,
+      19,      7,    243,    254,    252,      2,    252,    244,
+     248,     19,     26,      3,    249,    242,      3,      5,
+       1,    228,    244,      3,      4,     18,    246,    254,
+     253,    252,    253,      1,      5,     15,      9,    252,
+     251,    225,    250,     14,     14,      4,    254,      4,
+     249,     15,     11,      4,      4,     12,     11,      5,
+       7,     13,     16,     12,      6,    241,    251,    244,
+       0,      7,      2,     11,    252,     10,    245,    242,
+      20,     14,      0,    249,    254,    254,      5,    240,
+     234,    248,    240,    249,      1,      5,     10,    254,
+       3,     18,      0,    236,      1,     14,    250,      1,
+      13,    249,      3,     10,     13,     13,      9,      9,
+       4,      2,      1,      5,    234,    252,     22,     19,
+       7,    246,    253,    252,      3,    244,    250,     19,
+       3,    251,    253,      2,      5,      5,      7,    250,
+     233,    241,      0,     18,      3,    250,     10,    251,
+     251,    252,     12,      9,     11,     36,      6,      0,
+       1,    249,    254,    248,    249,    253,    251,      3,
+      13,      6,      3,    243,      3,      6,    248,      7,
+       3,      6,      6,    242,    241,      4,     10,      3,
+      10,     19,    250,    254,     14,    250,      9,      9,
+     250,    250,      7,      9,    251,      1,    234,      0,
+       1,    241,      2,      0,      7,      3,     18,     11,
+     250,    251,    248,     13,      3,      3,     14,      6,
+       3,      6,      4,    248,    243,     13,     15,     14,
+      13,    248,      2,    249,    244,      4,     10,      5,
+     250,     19,      7,    245,      2,    243,      7,      5,
+     244,      2,      2,    239,      0,     13,    240,    243,
+     251,      1,    252,      6,      6,    248,    252,      0,
+      18,      5,    249,      5,     23,     14,    252,    253,
+      18,      3,      1,     13,      0,      3,      9,     11,
+       6,    240,    240,     14,    253,      2,      7,      3,
+       3,      3,      1,    242,    239,    248,     12,    249,
+     252,      9,      9,      4,    235,    242,      0,      4,
+       4,     18,      1,    252,     10,    245,    252,     10,
+     253,      9,     23,      9,      4,     20,      6,    249,
+       5,      4,    243,    250,      6,      5,      9,    239,
+     249,     14,    236,    233,      4,      5,      5,     12,
+       2,      9,    252,      2,     20,    253,      1,     10,
+      12,      7,      4,    251,    249,    240,      6,     19,
+     250,    251,    253,      9,     11,    250,    234,    253,
+       5,      6,      0,      3,      9,    241,      4,      3,
+     249,      6,      2,     14,     19,    244,    250,      2,
+     243,      9,      4,    252,      7,      9,     10,    253,
+       0,      5,      0,      7,    252,    254,     13,     10,
+       5,     12,    244,    240,      4,    252,    253,      0,
+       1,    254,    252,    237,    254,     13,    250,      0,
+      14,     15,      4,      5,      9,    254,    244,    252,
+      16,     10,    252,     11,     19,      9,    242,    243,
+       4,    250,      4,      2,    253,      0,    248,      9,
+       3,    251,    253,    253,     16,      3,      1,     13,
+       2,      3,      7,    248,    243,     10,      6,      4,
+      12,    251,    244,      0,    250,      3,      0,    254,
+      13,      9,     12,    254,      5,     10,    245,      9,
+       1,    248,     16,      1,      1,     21,    244,    236,
+     254,      7,      5,    248,      6,      1,    241,    237,
+     249,      6,    250,    249,     16,     14,      0,     12,
+      14,    253,    252,      3,     10,      7,    254,      0,
+      14,     12,    248,    244,    253,      2,     11,      5,
+      11,     10,    250,    253,      2,      2,    250,    253,
+      14,      3,    253,      6,    251,      0,      3,    241,
+       1,     10,      0,      2,      0,    250,      5,      1,
+     245,      3,     10,      3,      0,      6,    248,      6,
+       1,    253,     13,      2,     10,    254,     10,    253,
+     242,      9,    248,    252,      1,      3,     12,      6,
+      12,    250,    237,    244,      5,     16,      1,      3,
+      11,     14,     10,      3,      0,    251,    245,      5,
+       6,      3,     16,    252,      4,     14,    252,    244,
+     252,      0,      7,      6,    252,    252,    251,    246,
+     248,      2,    253,      4,      5,    251,    249,     13,
+       7,    245,     10,    253,    254,      0,    254,     16,
+       4,      3,    254,    254,      5,    249,      3,     11,
+       3,     16,      0,    249,      6,      4,      4,    251,
+       7,     18,    251,    248,    251,    250,      9,    251,
+     250,      6,      2,      1,      9,      5,      0,    248,
+     237,      2,      9,      4,      6,     12,      6,      1,
+     248,    248,      3,      6,     11,      7,      9,    252,
+       0,     10,    252,    246,      4,    245,    251,      5,
+     252,      2,      4,      0,    248,    249,      4,      9,
+     254,      6,      1,    251,    252,      2,     11,    251,
+     250,      1,      6,     11,      3,    248,     11,      1,
+       2,      2,    250,     23,      9,      4,      6,    240,
+     251,      7,      7,     12,      7,     13,    254,    253,
+       2,    248,      6,      2,    254,      4,    252,      2,
+       1,    253,    250,    244,    248,    253,     12,      0,
+     254,     12,      4,    253,    249,    253,      2,      6,
+       4,      4,      4,    254,    249,    254,      4,    254,
+       6,      3,    254,     14,      5,    248,      4,      1,
+     254,      0,      2,     15,      4,      2,      6,      2,
+     252,    250,      5,     12,      5,      4,      6,    248,
+       2,    250,    244,      3,    251,      6,      6,    254,
+       3,      4,      3,    252,    250,      3,      4,     18,
+       4,    241,      2,      3,    249,    245,      2,      5,
+     253,      2,    244,    250,     10,    254,    253,      0,
+       1,    254,      6,     10,      4,      6,    254,      4,
+       7,      1,     11,     14,      2,      5,      1,    253,
+       3,      3,    253,      1,      7,    254,      9,    254,
+     249,    253,    253,      9,    252,    248,      9,     16,
+       5,    248,    251,    254,    254,    252,    253,      2,
+     253,      2,      3,    245,      0,      7,    241,    250,
+      12,      1,      4,      1,      1,    254,    254,      4,
+       3,     14,      2,      3,      5,      3,      7,    254,
+       4,      4,      2,      1,      1,      1,      3,      3,
+       5,    249,    252,     13,      2,    254,      0,      6,
+       4,    254,      0,    252,      6,      1,    244,      5,
+       0,    252,      6,      0,      1,    251,    250,      7,
+       5,      0,      4,      5,    252,    243,      5,     10,
+     251,      0,    253,    253,      7,      4,    254,      5,
+       3,    254,      1,    250,      1,      5,    253,    254,
+     253,      0,      2,      0,      6,      4,      1,     10,
+       4,      6,      2,      1,     13,      6,    254,      0,
+       0,      5,      4,      0,    252,      2,    251,    249,
+       7,      0,      4,      7,    254,    246,    251,      3,
+       1,    254,    250,      5,      4,      0,    252,      7,
+       4,    253,      3,      5,      5,    242,    254,     10,
+     254,      2,    254,    245,      0,     11,      1,    248,
+      11,      9,    251,      7,      6,      2,      4,      5,
+     254,      6,      3,    249,      5,    253,      0,    253,
+     253,      5,      2,      3,    251,    254,    252,      5,
+       6,    252,      2,      0,      5,    253,    250,      1,
+       5,     11,    253,      1,     10,      0,      0,      5,
+       0,      0,    254,    242,      4,      7,    248,      0,
+       4,      0,    246,    252,      7,      4,      6,      5,
+     252,      5,      6,      3,    248,    254,     11,    253,
+       1,      1,      1,      5,      0,      0,      3,      3,
+       7,    253,    254,     13,    254,    249,      0,      4,
+       5,    254,    251,      1,      6,      0,    251,      1,
+       2,      0,      4,      1,    248,    254,      0,    245,
+     254,      0,      2,    254,      0,      7,      1,      2,
+       3,      5,      6,      1,      0,      9,     10,      0,
+       1,      0,    252,      4,      1,    249,    254,      9,
+       3,    250,      5,      4,      0,      6,      1,    252,
+       7,      0,    253,      4,    252,      1,    251,    254,
+       4,      6,      2,    252,    253,    254,    251,    253,
+       2,    254,      5,      0,    250,    254,      3,      7,
+       5,      0,      5,      0,    253,     10,      6,      5,
+     252,    245,    254,      5,      4,    250,      1,      7,
+     251,    250,    254,      5,      4,      5,      4,    254,
+       7,      2,      0,      3,      4,      0,    252,      2,
+       4,      2,    253,     10,      1,    245,    253,      1,
+       2,      4,      6,    250,    242,    252,      4,    251,
+       0,    254,      5,      4,    249,      4,      2,    253,
+     254,      6,      2,    254,      5,    253,    252,      4,
+       3,    254,      1,      3,      1,      4,      7,      1,
+       3,      3,    253,      5,      7,      2,      1,    254,
+     254,      0,     10,    253,    245,      3,      0,    251,
+     251,      1,      3,    254,    254,    250,    252,      4,
+     254,      1,      6,    253,    254,    254,      3,     12,
+       6,      0,      2,      4,    252,    253,      3,      1,
+       0,      4,      1,    253,      5,      2,      3,      2,
+     251,      1,      2,      0,      6,      6,      0,      2,
+     248,    251,      9,      6,    251,    253,      3,    254,
+     251,      0,      3,      2,    254,    249,      2,      3,
+     253,      0,      1,      4,      0,    254,      2,      0,
+       2,      0,      1,      0,    250,    253,      3,    254,
+     251,      4,      2,      0,      1,    254,      1,      1,
+       6,      6,      2,      1,      2,     10,      5,      5,
+     254,    248,      9,      7,    253,      0,      6,      3,
+     253,    254,      0,      0,      3,      5,    254,    251,
+     254,    253,      1,      3,    252,      0,    254,    250,
+     253,    251,      0,      4,    253,    252,      0,    251,
+     251,      1,      3,      4,    251,      3,      5,      3,
+       4,      3,      9,    254,    250,      5,     12,      5,
+     253,      1,      1,      3,      9,      1,      0,      1,
+     252,      2,      2,    253,      0,      1,      1,    254,
+       1,      0,    251,      4,      0,    252,      2,    254,
+       1,      1,    253,      0,    253,    253,    253,    254,
+       5,      1,      0,    253,    253,      3,      0,    254,
+       3,      2,    254,      2,    254,    254,      6,      4,
+       2,    251,    251,      3,      3,      4,      3,      3,
+       3,    252,      3,      6,    253,      2,      6,      1,
+       2,    252,    249,      2,      2,      5,      5,    253,
+     252,      2,      1,    251,      1,      2,    253,    253,
+       0,    253,      0,      0,    251,    253,      2,      0,
+     251,      4,      2,      1,    253,    249,      2,      3,
+     254,      0,      2,      2,      4,      3,      1,      2,
+       6,      4,    253,      3,      5,      4,      1,      1,
+       4,      2,      0,    254,      1,      1,      0,      2,
+       0,    254,    253,    253,      2,      1,      1,    253,
+     248,      1,      2,    254,    246,    246,      5,      9,
+     254,    251,      1,    254,      1,      2,    253,    253,
+       4,      2,      1,      1,    251,      0,      2,      3,
+       3,      4,      0,      3,     10,      1,    254,      3,
+       3,      4,      5,    248,    251,      6,      4,      3,
+       0,    254,    253,      1,      2,    254,    253,      0,
+       2,      1,    253,    251,      4,      0,      0,      7,
+     251,    251,      1,      2,      0,    251,      0,      2,
+       1,    252,    251,      3,      4,    252,    253,    254,
+       0,      2,      1,      1,      1,      3,      3,      1,
+     254,      2,      1,      0,      0,      1,      2,      1,
+       3,      5,      1,      0,      1,      2,      5,      4,
+     252,      3,      3,      1,    252,    249,      3,      3,
+       1,    254,    254,    254,    254,      0,    253,    254,
+     252,    254,      0,      0,      0,    251,    252,      4,
+       6,    254,    253,      2,      1,      3,    254,    252,
+       3,      4,      1,      1,      1,    254,      4,      3,
+     252,      0,    254,      0,      0,      2,      6,      0,
+       0,    254,      1,      3,      0,      1,      1,      1,
+       0,      1,    254,    253,      1,    252,    253,      3,
+       4,    254,    252,    254,      0,      4,    254,    251,
+       0,      1,      1,      0,    251,    251,      4,      1,
+     254,      4,      1,    254,      3,      1,      2,      2,
+       0,      2,      2,      1,      0,      4,      1,      0,
+       2,    254,      2,      5,      2,      0,      0,      3,
+       1,      1,      2,    253,    254,    254,    253,      3,
+       0,    253,    254,    254,    254,      2,      2,    253,
+       0,      1,    251,    251,    254,    254,    254,      0,
+     254,      0,      0,    253,      1,      2,      4,      2,
+     253,    253,      4,      4,      0,      1,      1,      3,
+       1,      2,      4,      1,      6,      3,    254,      0,
+       0,      1,      1,      0,    253,    254,      1,    253,
+       1,      1,    254,    254,      0,      2,    254,    254,
+       0,    255,      0,    255,      0,    255,    254,      1,
+       0,    255,    255,    254,    252,      0,      5,      0,
+       0,    255,    255,      1,      1,    254,    253,      0,
+       0,      2,      0,    254,      2,      0,      0,      3,
+       3,    255,      0,      1,    255,      0,    254,    255,
+       1,      1,      1,    255,    255,      1,      1,      0,
+     254,    255,      1,    253,      0,      0,    253,      0,
+       0,    255,      0,    254,      0,      1,      0,    255,
+     254,    254,      0,      1,      2,      0,    255,      2,
+       0,      0,      1,      0,      1,      1,    255,    255,
+       0,      1,      0,      0,    254,    254,      0,      0,
+       1,      1,      0,      0,      1,    255,    255,      0,
+       0,      0,    255,    255,    255,    255,    255,    255,
+     255,    254,      0,      2,      0,    254,    255,      3,
+       1,      0,    254,    255,      2,      1,      0,    253,
+     255,      1,      1,      1,      0,      1,      0,      0,
+       0,      0,    255,    255,      0,      0,      0,    255,
+     255,      1,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,    255,    254,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      1,      0,      0,    255,    255,
+       0,    255,    255,      0,      0,      0,      0,    255,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,    255,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+};
+#endif  // NUM_HH_SAMPLES > 1
+
+#if NUM_HH_SAMPLES > 2
+static const prog_uint8_t hh_sample_dt[] PROGMEM = {
+     254,      0,    253,      1,    253,      0,      0,    243,
+      12,      4,      9,    237,    241,     55,    228,      5,
+      76,    226,    217,      2,     37,      4,    204,     65,
+      72,    163,    172,     72,     34,    225,     41,     19,
+     218,    219,     10,     45,      0,    198,     11,     31,
+     210,    244,     62,     32,    203,    238,     23,     46,
+      58,    241,    212,    228,     18,      9,    213,    227,
+      39,    225,    177,    243,    227,    252,    217,    227,
+      19,    231,    228,    246,    238,    225,      2,      8,
+     200,    206,     71,     28,    171,    236,     12,    240,
+     206,    245,     25,    210,    212,      9,     16,    227,
+     224,     22,     44,     10,    239,     14,    250,    248,
+      35,    238,    241,     37,     19,    243,    223,    247,
+      36,      7,      2,     30,    247,     14,     48,     27,
+     251,     34,     64,     14,      1,      1,     35,     65,
+     253,    224,      7,     41,     23,     57,     76,    234,
+      31,     31,    241,     38,     25,      3,    246,     21,
+       0,    250,     31,    241,    239,    254,     29,    247,
+     214,     27,    232,    238,      2,    226,    241,    184,
+     238,     46,    233,    199,    225,    251,      7,    230,
+     210,     24,      9,    206,    232,      4,      8,    203,
+     206,    253,    243,     43,    209,    184,     14,    226,
+     205,      4,     29,    167,    213,     11,     42,     54,
+     191,      0,     48,     22,    243,    219,      4,     12,
+      30,    100,     45,    233,     24,     72,     62,     25,
+      56,    241,      3,     21,    254,    228,    206,    245,
+     219,      2,    203,    244,    217,    214,     78,    246,
+       0,    225,    219,     55,    220,    236,     37,    201,
+     186,    244,    243,    212,     14,     27,    236,    197,
+     209,     39,     11,    250,     11,    227,    220,     15,
+      23,     12,     52,     45,    232,    243,      4,     28,
+      25,    193,    232,      3,      5,     12,     39,     46,
+     219,    218,     44,     32,      3,     21,    203,    187,
+      68,     15,    182,     16,    250,    248,     27,    232,
+     231,    237,     30,      8,    158,    160,    232,     43,
+       5,    213,    198,     15,     99,      4,    217,    230,
+     213,     23,     11,     11,      8,     10,     29,    244,
+      25,      9,     21,    230,    233,     35,     27,    246,
+     212,     22,    239,    221,     62,    216,    189,      2,
+      42,     75,    220,     19,     18,     59,     38,    198,
+      29,    239,      2,     44,     18,    234,    211,      4,
+      35,     82,     14,    218,    232,     61,     38,    135,
+       8,    252,    207,     24,    232,     52,    227,    205,
+      72,     43,    240,    184,     58,      4,    189,     65,
+     232,    241,    247,    254,     77,    197,    226,    239,
+     232,    240,    147,     43,     68,    224,    224,    247,
+      29,    220,     32,    246,    190,     50,    251,     21,
+       7,    245,     42,     21,    230,    225,    231,     21,
+      37,      0,     73,      5,    231,     59,     55,     19,
+     220,      1,     35,    248,    234,     12,     16,    239,
+       5,     38,     37,    203,    247,     41,    226,    248,
+     231,    246,    240,    212,    232,     17,    239,    220,
+      25,    198,    226,    230,     14,     46,    198,      1,
+       9,    245,    221,     24,     50,    193,    228,     48,
+      22,    250,      8,    197,    251,     44,     12,     37,
+     238,      8,     48,     54,    245,     23,     50,    239,
+      19,     27,     29,    198,    224,     18,     31,      7,
+     231,     51,    159,    207,     19,     24,     38,    174,
+     234,    243,     29,    244,    216,    253,    233,     35,
+       4,    239,    189,    234,      2,     45,     28,    177,
+     227,      4,     12,    244,     44,    232,    206,     37,
+      43,     52,    236,      8,     15,     18,     17,    239,
+       3,    241,     27,      0,     48,    239,    254,     37,
+     171,     64,      2,    217,    210,    151,     64,     48,
+     197,    211,    254,     32,     30,    197,    200,    253,
+     230,      8,     49,    231,    221,     18,     25,      9,
+     245,     14,     19,    228,      0,     45,     27,    241,
+     190,     11,     18,     59,     42,    241,     15,    211,
+      82,     24,    177,    241,     29,     44,    184,      4,
+      10,    187,    233,     24,     17,    204,    240,    240,
+      23,    248,    186,    251,    219,    228,    226,    206,
+       7,     36,     11,     11,     35,     42,    246,    237,
+      10,    220,      1,     55,    238,    239,     56,     39,
+     245,      8,    245,    241,     24,    245,     18,    179,
+     246,      8,    211,     95,      5,     25,    237,    217,
+      72,     32,    192,    247,     23,    197,     65,    189,
+     223,     46,    233,     51,    193,    232,     29,    240,
+     219,    245,     50,    217,    179,     22,     24,    230,
+      45,     32,    236,    191,    230,     66,    231,      9,
+     247,      0,     30,    217,    246,    248,     24,      8,
+     245,    254,    244,    213,    254,     46,    253,     25,
+     201,    246,     63,    218,     17,     32,    228,    230,
+       3,     43,     55,     22,    241,     18,     25,    214,
+     226,     71,      5,    167,     50,     27,    216,    223,
+     225,     54,     28,    228,    212,    187,    214,     29,
+      11,    224,    217,    200,     14,     18,    239,    251,
+     230,    245,      8,     49,      0,    228,     27,     14,
+      49,    213,    182,     75,     15,    241,     39,    240,
+       4,     39,     46,      9,      0,     61,    240,    221,
+     234,    250,     68,    231,    211,     29,     42,    237,
+     211,     31,    252,     10,      7,    209,    220,    221,
+       8,    245,     25,    220,    187,     66,    252,    180,
+     214,     51,    234,    160,    210,     31,    118,    224,
+     240,     35,    243,    236,    212,     77,     42,    247,
+      63,    246,    206,      8,     19,     42,      0,    231,
+      59,     50,    244,    233,    234,     44,     31,    200,
+      11,     17,    212,     18,    243,    183,    220,    223,
+      44,     61,    219,    185,     17,     38,    239,    224,
+     233,    248,    213,      9,     11,    247,      4,     29,
+      36,      8,     35,    239,    219,     62,     31,    241,
+      42,      2,    219,    217,     29,     35,    244,      9,
+      21,     10,    207,    158,    230,     69,    213,    193,
+      24,    245,    204,      5,     22,    224,     28,     55,
+     162,    170,     66,     36,     46,    252,    183,    236,
+      17,     19,    244,     59,     37,    224,     46,     28,
+     191,    248,     68,    244,     18,     55,    236,     30,
+      63,     27,    236,    245,    246,     56,     55,    191,
+     205,    223,     34,     24,     12,    225,    143,    245,
+      45,    253,    179,    203,     14,     12,    223,    187,
+     212,     39,      7,    176,     25,     21,    158,     17,
+      71,    201,    239,     66,     32,     31,    243,    246,
+      54,     76,     30,    213,     49,     39,    193,    254,
+       5,    248,     54,     84,     14,    176,    216,     54,
+      31,      7,    247,    199,      9,      2,    209,    232,
+     250,    227,    240,     44,    193,    150,     62,      2,
+     217,     19,    166,      7,     55,    227,     11,    204,
+      30,     68,     43,     55,    183,    218,     17,     50,
+      50,    233,      1,     62,     90,    200,    190,     17,
+     214,     84,     58,    187,    207,    248,     12,    230,
+     251,    245,    225,      7,     44,    224,    178,      2,
+      12,      2,    245,    228,    251,    252,      1,      3,
+      75,     61,    164,    252,     17,    189,     51,     58,
+     236,    251,      7,    234,      7,     44,    228,     65,
+      52,    200,      1,    227,      9,    252,     38,     42,
+     227,    237,    197,      2,     17,     16,    218,    220,
+     253,    225,    244,    213,    214,    241,     45,     45,
+     218,    185,     11,    253,     14,     50,    231,    252,
+      44,     28,    236,     16,    221,     30,     38,      1,
+      58,    211,     23,     16,    226,     72,     55,     12,
+     251,    250,    238,    243,     14,    212,     28,     41,
+     207,    201,    225,     25,    244,    230,    254,      7,
+     225,    193,    250,     21,     23,    233,     18,     39,
+     153,    211,     52,     45,    238,    213,      4,    252,
+      24,    219,    232,    106,     58,    196,      8,    254,
+     216,      2,    211,     43,     63,    221,      2,     42,
+     248,    234,      1,     59,     19,    210,     63,      4,
+     220,    253,      7,     39,    234,      0,    203,    218,
+      28,      0,    252,    211,     11,    223,    217,     44,
+      46,    213,    204,     55,     41,     39,    187,    192,
+     251,     15,     92,    252,     37,      4,    159,     37,
+      23,    225,     27,     55,     29,    203,    232,     11,
+      21,     11,    209,     12,    203,    176,     35,     45,
+     247,    239,     48,    231,    165,    214,     16,     54,
+       0,    245,    217,    216,    236,    241,     44,     38,
+      31,    238,     49,     21,    172,      4,    250,     48,
+     253,    203,    115,     86,    213,    212,     34,     54,
+     238,    192,    232,     22,     14,    245,     22,    238,
+     247,     25,    251,     19,    223,      4,    231,    192,
+     230,    243,      4,    225,     29,    228,    200,     66,
+      43,    238,    224,    239,      5,    203,    206,     59,
+     108,    220,    220,      0,    211,     41,    252,     43,
+      21,    212,    240,    233,     43,    194,    247,     57,
+     233,    238,    232,      8,     39,     79,    200,    213,
+      22,    212,     51,    250,    216,     21,     62,    254,
+     218,     25,    211,     12,     61,     11,    243,    220,
+       3,      7,    192,      9,     38,      9,     44,    246,
+     241,    207,    243,     43,    240,      2,    205,    232,
+      29,      1,     58,    201,    162,     76,     97,    212,
+     180,     35,     50,    254,    223,    193,    231,     36,
+     253,    200,     35,     27,    227,     39,     14,    174,
+     194,     64,     46,     19,      7,    230,     14,     15,
+       1,    251,    238,     24,     55,      7,    252,    203,
+       7,     85,     14,    209,    209,     37,     57,      5,
+     240,    252,    228,    220,     15,    214,    203,     28,
+     246,    250,    219,    197,     22,      1,    225,     24,
+      27,    253,     57,    232,    194,    224,    217,    245,
+      34,     49,     10,    245,    247,     46,      7,    230,
+     248,     12,     23,     48,    232,    230,     30,    223,
+       7,     29,    253,    234,      2,     48,    245,    185,
+      22,     24,     16,     27,    212,      1,     62,     18,
+      11,      8,    209,    213,    212,     38,    245,    233,
+      12,    200,     34,    245,    187,      7,     36,    240,
+     240,      8,     34,     15,    191,     14,     21,    232,
+      51,     11,    216,     38,     38,    245,    232,    225,
+     251,     12,    248,    238,      7,    253,     32,     34,
+       2,    210,    179,     52,     61,      1,    245,    200,
+     250,      7,    198,    254,      8,     31,     45,      5,
+      24,    226,    184,    231,     92,     35,    226,    240,
+     246,     63,      1,    230,      7,     32,    214,    233,
+      51,    191,    207,    219,     68,     62,    128,    224,
+      59,     65,    243,    224,     71,    207,    193,    246,
+     206,     31,    240,    246,     48,    230,     10,    243,
+     250,     75,    240,    216,      4,      0,     30,    248,
+     237,     41,     10,    227,    200,     22,     68,    232,
+     225,    225,     32,     28,    186,     43,     39,    223,
+     253,     64,     97,    163,    194,     51,    254,      2,
+     253,     11,    240,    246,    241,    200,      7,    233,
+     232,     51,     12,    230,    214,    234,     12,    244,
+     237,      5,    239,     39,    240,    146,     34,     46,
+      23,    234,    218,     56,    254,    231,    241,     24,
+      64,    234,    247,     24,    252,     10,     18,     50,
+     231,    209,     64,    250,    239,      1,    236,     70,
+      21,    218,    212,    226,     45,    251,    233,      8,
+     236,    232,     30,    254,    197,      7,    219,    237,
+      49,     39,    199,    187,     70,    244,    247,     16,
+     247,     49,      0,    199,    214,     44,     16,    252,
+      11,    250,    248,    233,     27,     24,     23,    247,
+     189,      1,     31,    232,    244,     44,     38,      1,
+       5,    236,    191,    238,     11,     62,     34,    253,
+     228,    173,     24,     24,    233,     22,     15,    250,
+     254,      2,    221,    248,     49,    233,    243,      9,
+     178,     24,     75,    234,    238,    220,      0,     14,
+     252,    254,    254,     41,    246,    243,    253,    246,
+     251,     10,     12,     14,      0,      0,     27,    196,
+      10,      2,    201,     29,     21,     19,    221,      2,
+      42,    179,    236,     28,      5,     23,    187,    238,
+      62,    254,    251,      3,    241,    251,     21,    241,
+     221,     23,     19,     37,     17,    218,    241,    218,
+      54,     68,    231,    231,    250,     39,    233,    219,
+     230,    224,     46,     54,    244,    226,      7,    227,
+     216,     30,     11,    251,      1,    228,      2,     18,
+       5,    207,     10,     43,    226,     15,      0,      9,
+     223,    209,     45,     34,    233,    199,     11,     17,
+      59,     41,    192,    220,      0,     25,    216,      2,
+       3,    247,     86,     15,    247,    187,    227,     81,
+      16,    233,    205,    225,      7,      7,    251,    252,
+      15,    240,    252,     50,      5,    244,    220,    238,
+      79,     22,    204,    213,     32,      1,    231,     50,
+      16,    227,    218,    247,     11,     41,    240,    219,
+      61,    254,    225,    241,     25,     15,    176,     34,
+      56,    236,    212,    194,     25,    245,    231,     48,
+     250,    246,    234,    247,     28,    230,     15,      5,
+     220,      2,     37,    219,      3,     77,    231,    254,
+     241,     41,      9,    220,     54,    252,      1,     12,
+     225,    213,     34,     48,    196,    246,     32,    217,
+     239,     27,      0,    214,    251,     22,     12,     38,
+     244,    218,    251,      7,    248,      2,      9,    211,
+      22,     31,    206,    197,    244,     35,     27,     50,
+     214,    172,     35,     77,     52,    186,    226,    238,
+     218,     76,    231,    240,     69,      0,    232,     25,
+       0,    182,    227,     85,     29,    194,    245,     32,
+      23,    233,    248,     39,     18,    234,     14,    224,
+     201,     25,      9,      8,    226,     12,     25,    221,
+      41,    247,    253,     16,    246,    244,    194,    244,
+      21,     62,    240,    179,    245,    253,     28,    252,
+     220,    248,    234,     14,     66,     39,    197,    199,
+      86,     34,      5,    254,    201,     49,     10,    210,
+     227,     15,     79,     17,    209,    220,    220,      4,
+      57,      7,    223,    234,    230,     19,      7,    201,
+     254,     36,     39,    227,    158,      8,     41,     21,
+      35,    241,    236,    252,    247,     41,     63,    241,
+     230,     22,      3,    216,    220,     22,     21,     43,
+       2,    218,     17,    241,      4,    237,    216,     31,
+      12,    218,      3,     11,    225,      2,     71,    246,
+     183,      9,    252,      3,     25,      9,    225,    210,
+      31,     16,    236,     29,     16,      3,    251,    225,
+       4,     17,     21,     27,    237,    221,    251,     22,
+      44,    248,    200,    228,     25,     39,      3,    243,
+     223,     37,     21,    191,     32,      3,    200,     45,
+      23,    240,    237,     17,     21,    210,      3,    224,
+     203,     10,     12,    227,    254,     51,      5,      0,
+     232,     12,     10,    243,      7,    233,     21,    241,
+     220,     34,     46,      4,    240,     49,      8,    204,
+     233,     29,     21,    220,    231,    251,     34,     11,
+     240,     22,     10,    184,    233,     30,    221,     19,
+       0,    221,    252,     48,     31,    213,    251,     27,
+      27,    220,    232,     11,    223,    246,     15,     10,
+     240,    241,     42,     11,    228,     15,     16,    224,
+      21,     29,    237,    254,      0,     17,      1,    239,
+      59,     23,    210,     24,    254,    236,      8,    247,
+      11,    196,    232,     56,    247,    248,    219,    219,
+      37,     25,    247,    179,    234,     57,    252,    227,
+     251,     36,     16,    238,    251,      7,      9,     18,
+     238,      4,     35,    224,    225,      2,     36,     11,
+     240,     14,      1,     28,    244,    240,     37,    206,
+     212,     30,     45,      5,    205,    228,     21,     16,
+       0,     18,    232,    224,    232,      9,     63,    231,
+     209,     17,      1,    253,      4,    244,    243,     28,
+      22,    167,    221,     59,     34,    241,    234,     68,
+       3,    224,     32,    248,    245,    226,     16,     42,
+     241,    244,      0,     19,      4,    250,    241,      0,
+     237,    239,    247,    221,     49,     21,      2,     11,
+     250,      8,    221,    248,    246,     11,      8,    234,
+     252,    236,    239,    239,     30,     37,    238,    236,
+      10,    231,    226,     11,      8,    254,    210,      1,
+      15,    251,    248,    226,      3,     49,     18,    198,
+     251,    254,     44,     35,    223,     39,      4,     11,
+      23,    247,     19,    252,      7,     17,    247,    184,
+     247,     64,    225,     11,    237,    232,     75,     18,
+     211,    230,     25,    252,    239,      5,    232,    218,
+      10,     30,     12,    241,    243,     39,    244,    216,
+       1,    219,     18,     63,      0,    210,    221,     24,
+      12,     10,     12,    250,    238,      0,      2,    217,
+     205,    247,     55,     24,    233,    224,    246,    246,
+      29,     29,    191,     30,     46,    204,    213,      8,
+      44,    246,     22,     45,    232,    224,     48,     43,
+     226,    241,    234,      9,      0,    224,     31,     21,
+      28,     17,    243,     14,    253,    251,    247,    228,
+     234,    254,     18,     22,      5,    238,    205,     17,
+       9,    244,     16,    206,    254,     12,    226,      0,
+      15,    254,    209,    250,     29,      3,    233,    236,
+      62,     19,    237,    209,    219,     42,     36,     44,
+     211,    226,     37,     25,    251,    221,     34,     16,
+      21,      5,    219,    228,    254,     39,    221,     10,
+      32,    247,     24,    225,    247,     12,    241,     19,
+      17,    216,    204,    245,     16,     23,    240,      3,
+       9,    232,    254,     14,    231,     12,     34,    223,
+       7,    251,    246,     10,     10,    243,    237,     37,
+      11,    252,    236,    237,    234,     11,     28,    211,
+      14,      7,    214,      7,     16,     14,     22,      7,
+     240,     36,    251,    218,     51,    250,    231,     17,
+     226,    243,      8,     12,     16,    247,    232,    241,
+       0,    248,     32,     14,    207,      5,      0,      0,
+      54,    241,    197,      9,     54,     14,    248,    240,
+     243,     15,    219,     11,     30,    254,     29,    243,
+     233,    252,     19,      8,    240,    230,    248,     12,
+     206,    227,      8,     16,     39,    225,    228,      7,
+       9,    245,    248,     39,      0,    252,    232,      8,
+      30,    245,     14,    252,     14,     25,    241,    211,
+     254,    253,    252,     17,     16,     19,    203,     25,
+      52,    216,    224,     22,    254,    205,     27,     37,
+     237,    213,     15,     35,    223,    244,    246,      5,
+     251,      3,    247,    228,     36,    220,      3,     12,
+     252,     21,    239,     24,    251,     16,    225,    234,
+      24,    252,     30,    245,    233,    254,     17,    233,
+      32,     51,    203,    223,     11,     12,    234,      8,
+      27,    210,    219,     35,     27,    230,    217,    241,
+      41,     35,    224,    220,    240,     16,    251,    244,
+      16,    234,     14,     51,      3,    218,      5,     19,
+     243,    250,    253,    239,    246,     35,     15,      5,
+       8,    237,     23,     27,    239,    231,      3,    246,
+     214,     34,     24,    236,    241,     21,     19,    225,
+      25,    241,    239,      7,    239,    236,    253,     39,
+      14,    224,    226,     21,      9,    248,    237,    210,
+     240,     10,     12,    245,    214,     12,     35,     17,
+       0,    209,    236,     32,     78,      7,    196,    246,
+      41,     30,    239,     14,     11,    251,      3,     22,
+       4,    227,     12,     12,    234,    254,      4,     14,
+      21,    238,    236,    219,      1,     34,    210,    224,
+      29,      0,    252,     21,    251,    233,    244,    251,
+      44,     14,    187,    237,     11,     31,     21,    217,
+     236,      4,      8,    237,      2,     10,    248,     28,
+     245,    230,    238,    251,     43,     23,    247,    238,
+      12,     15,      0,     15,    236,    250,     28,    226,
+     225,     41,     16,    228,    236,    250,      1,    250,
+      31,    245,    236,     21,    228,    251,    250,    250,
+      23,    254,     10,     39,    223,    228,     45,      0,
+      12,    238,    240,     19,    233,      1,     23,      8,
+     212,    252,     17,      7,      8,    225,      2,    247,
+       1,    252,    239,    244,      8,     30,    250,      9,
+     209,    224,     52,      1,    245,    248,    247,     18,
+       7,    246,    246,    254,     10,     12,    252,    251,
+     243,    251,     14,     22,    244,    244,     10,    240,
+      19,     43,    239,    226,      0,    237,     27,     25,
+     225,      8,      8,    240,     21,    250,    239,     18,
+     236,    204,      4,     48,      9,    251,    252,    240,
+     238,     34,     18,    211,      1,    248,      3,     17,
+     216,    233,      1,      8,      3,    241,      8,    251,
+     237,    250,     14,    251,    230,     22,     12,      3,
+      27,      5,    248,     23,    240,    225,     41,    251,
+     248,     42,     11,    221,    217,     12,     11,    248,
+      11,    254,    247,    248,      8,      5,    240,     10,
+     247,      1,    233,    230,     24,     14,     18,    239,
+     227,     18,      5,    246,     10,    225,    244,      2,
+       2,    248,    224,     15,      7,     16,    251,    213,
+       3,     34,     14,    252,    221,    230,     46,     31,
+       2,      1,    238,    253,    252,     12,      7,    206,
+       3,     48,      3,    246,    248,    248,    245,     17,
+      15,    231,    243,      7,     19,    243,    240,     15,
+      17,     12,    254,    250,    210,      3,     58,      1,
+     211,    209,      8,      1,      4,    252,    232,     48,
+       4,    204,    244,      2,      5,    254,     15,    250,
+     219,      7,     27,     24,     14,    243,    234,     16,
+      35,    240,    218,    241,     15,     14,    238,    252,
+       9,     11,     15,     10,      5,    223,    245,     21,
+      15,    241,    212,     22,     39,      0,    225,    246,
+      18,    248,      0,    230,     16,    254,    218,     34,
+      10,    226,    238,     29,     18,      9,    238,    238,
+      24,      5,    254,    221,      9,     56,     12,    214,
+     221,      3,     17,     21,      1,    251,    238,    252,
+       7,      8,    244,    212,      9,     24,    206,    210,
+      22,     19,     12,      5,    234,    250,    237,      9,
+      25,    251,    253,    236,      1,     19,      9,    247,
+     237,     17,     32,    250,    232,    246,      4,     38,
+     250,    225,      9,      1,     15,      9,    248,    253,
+     244,      1,     10,      2,      0,      7,     12,      1,
+     252,    241,    245,     10,    247,    238,    245,    244,
+     250,      0,      3,      3,    252,    250,    253,      1,
+     254,    244,     12,     15,    230,    240,      1,     12,
+      28,     11,    254,    225,      1,     10,    227,     16,
+       7,    251,    248,      1,     24,    253,    248,     14,
+     250,      1,    252,    234,     18,      4,    253,    247,
+       8,     15,    238,      7,     15,    253,    253,    254,
+       1,      0,    241,      2,     14,    236,    232,      1,
+      21,    250,    225,      5,    253,      9,    251,    233,
+      16,    253,      9,      8,    236,    236,    240,     11,
+      22,    245,      3,     11,    237,    240,     21,     14,
+     239,    252,      7,      1,    245,     23,     15,    247,
+      11,    240,    240,      0,      3,     23,      0,    247,
+       0,    240,    240,    250,     18,      3,    250,    248,
+     241,     11,      1,      4,      4,    234,    239,      7,
+      39,    253,    239,      2,    236,     15,      3,    238,
+       8,     10,     11,    243,    245,      0,    234,      3,
+      29,      5,    216,    236,     28,     37,    250,    218,
+      14,     10,    247,    250,      8,    253,    247,     23,
+     247,    247,    244,    251,      7,    247,     17,    251,
+       1,      7,    228,    239,    253,     19,     18,    248,
+     238,    241,     12,     17,      5,      5,    238,    232,
+      12,     35,     22,    224,    232,     25,     17,      1,
+     228,    246,     31,     16,    240,    226,    245,     16,
+      23,    254,    243,    231,    244,     23,      2,    240,
+     236,    237,      8,     24,    239,    243,     18,    246,
+     243,    248,    240,    236,     28,     15,    238,      2,
+       1,     12,      1,     10,    241,    254,     34,    245,
+     247,    247,    252,     17,     19,    247,    247,      5,
+      15,     16,    226,    252,      4,     15,      2,    228,
+     252,    250,      5,     12,     12,    246,    236,    245,
+      32,      4,    237,      9,    230,     15,      9,    236,
+     240,    244,     10,     15,     16,    213,    243,     15,
+     243,      7,    230,    252,     12,     15,      5,    224,
+     238,     17,     36,     11,      3,    247,    244,      4,
+      24,    253,    228,    245,    252,     15,     10,      0,
+     236,      9,     25,    237,    241,    246,    248,      4,
+       0,    245,      0,     15,     24,     21,    228,    244,
+      19,      2,     18,     10,    226,    227,     15,     14,
+     234,    254,      3,    253,     12,    244,    238,    234,
+     245,     21,      4,    237,    231,    254,     17,      5,
+       5,    248,      1,      8,    248,    252,    248,     16,
+      21,     14,    241,    244,    253,    245,     19,      2,
+       7,    254,    241,    251,      4,      3,    232,     14,
+      28,    236,    253,     10,    252,      8,      1,    253,
+     245,    252,    251,     12,     22,    224,    247,      9,
+       0,     16,    241,      9,     10,    239,    240,    250,
+      12,      9,     16,    238,    234,    252,      2,     24,
+     252,    246,    243,    239,      2,      9,      4,      9,
+       4,    251,    252,    246,    252,     24,     17,      2,
+     254,    217,      2,     17,    240,      4,      9,    253,
+       0,      0,      9,    240,    234,     21,     21,    241,
+     231,    247,    247,     11,     14,      0,    253,    241,
+     248,      2,      4,      0,      9,      7,    240,      1,
+       7,      0,    248,      5,     24,    246,    240,      1,
+       5,     17,    245,    234,    253,    241,     16,     24,
+     241,    247,    244,    246,      7,      4,      0,      3,
+      15,    234,    237,      4,    245,     19,      7,    241,
+     252,    236,    246,     21,     19,    250,    231,    250,
+       4,    253,    251,      4,     16,    246,    243,    253,
+       2,     18,      7,      4,      9,    238,    254,     21,
+     246,    250,     19,     12,    248,      0,    248,    238,
+       8,     17,      1,    252,    244,    246,      2,    250,
+       7,      7,    238,    253,    252,     12,    253,    237,
+      21,    245,    250,    250,    238,     17,     10,    254,
+     233,    245,      7,    253,      9,      2,    244,    254,
+       1,    251,      1,     10,     12,    244,      1,    254,
+     243,     10,     10,     12,      5,    233,    244,     15,
+       0,      8,    254,    238,      4,    243,    252,      3,
+     250,      3,      1,      9,    237,    241,      9,      8,
+      10,    245,    251,      5,    250,    253,      5,      9,
+       7,    246,    250,      8,    251,    245,      2,     18,
+      12,    237,    241,      3,      9,    254,    254,    252,
+     250,      2,    246,      2,     11,    253,      1,    252,
+     243,      0,      0,      7,      5,    238,    250,      4,
+     252,     10,      1,    251,      4,    250,    252,    245,
+     252,      9,    246,    243,      5,      5,      4,    246,
+      10,     17,    245,      2,    243,      3,      7,    250,
+       3,    252,     19,    248,    243,     11,      1,    252,
+       4,      9,    246,    245,    251,      1,      1,    252,
+     252,      0,    250,    251,      4,    253,      5,      0,
+     245,    244,    252,      0,      0,      7,      1,    250,
+     232,    254,     17,      2,      9,    254,    254,    254,
+     244,      3,     17,      3,    239,      3,      0,    250,
+      17,      8,    253,    239,    245,     11,      1,    248,
+     251,      0,    244,      4,     12,    241,    245,      7,
+      12,      0,    247,      0,    250,    254,     10,      1,
+     244,    253,      9,    250,      1,      1,    254,      2,
+     244,      5,    254,    248,      5,    247,      5,      1,
+     241,    251,      0,      3,      3,      2,    252,    244,
+     254,      7,      9,      4,    237,      1,      9,    250,
+       1,      7,      1,    253,    251,      1,      1,    247,
+       7,     10,    248,    251,    250,    251,      5,      3,
+     252,      4,    248,    245,      4,    254,      8,      0,
+     252,    254,    244,      2,     10,      1,    254,      0,
+     244,      3,      9,    248,      3,      0,    250,      2,
+     252,    248,    248,      3,      4,      2,     10,    250,
+     246,      7,      3,    245,    254,      3,    247,    251,
+       2,      8,      0,    254,      7,    248,    251,    250,
+     253,     16,      2,    252,    250,    251,      7,      0,
+       1,      0,    247,    248,    250,      0,     11,      0,
+     246,    252,    251,    246,      7,      7,      1,      2,
+     238,      4,      7,    252,      3,    254,    254,      1,
+       1,    252,      8,      1,    248,      7,      8,    248,
+     244,      0,      3,      4,    252,    245,    254,    255,
+       3,      0,    251,    254,      2,      0,      1,    254,
+     253,      4,      0,      0,    255,      0,      0,      0,
+       0,    253,      2,    253,    251,    253,    254,      0,
+     251,      2,      2,    254,    254,    251,      1,      3,
+       0,    251,    252,      0,    255,      1,      7,    249,
+     248,      4,      5,      2,      2,      2,    248,    253,
+       3,    255,      0,      3,    254,    248,      2,      1,
+     253,      3,      0,    249,    248,      0,      1,    253,
+       2,      4,    249,    253,    254,    253,      2,      2,
+       0,    254,      0,    250,    254,    255,    255,      5,
+     251,    253,      5,    254,    253,      5,      1,      1,
+       1,    251,    255,    255,      1,      1,      3,      1,
+     251,    254,      0,      5,      0,    249,      0,    255,
+     250,      0,      1,    255,      0,    254,    255,    254,
+     253,    255,      0,      1,    254,    253,      2,      2,
+     255,    255,      0,    254,    255,      2,      0,    254,
+       0,      1,      0,      0,      0,    255,      3,      3,
+     255,    254,      0,      0,      0,      1,      0,    253,
+     254,      2,      1,      0,    253,    255,      1,    255,
+     253,      0,    254,      0,      1,      0,      1,    253,
+     254,      1,      0,      0,      0,    255,      2,    255,
+     252,    255,      1,      2,      0,    254,    254,      0,
+       1,      0,      0,      0,      0,      0,      0,      2,
+       0,    254,      1,      0,    255,      0,      2,      1,
+     255,    255,      0,      0,    255,      0,      0,    255,
+     255,      0,      0,      0,      0,      0,      0,    255,
+       0,      1,    255,      0,      0,    255,      0,      0,
+       0,      1,      1,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+       0,      0,      0,      0,      0,      0,      0,      0,
+};
+#endif  // NUM_HH_SAMPLES > 2
+
+#if NUM_HH_SAMPLES > 0
+const prog_uint8_t* hh_sample_table[] = {
+  hh_sample_909,
+#if NUM_HH_SAMPLES > 1
+  hh_sample_linn,
+#endif  // NUM_HH_SAMPLES > 1
+#if NUM_HH_SAMPLES > 2
+  hh_sample_dt,
+#endif  // NUM_HH_SAMPLES > 2
+};
+#endif  // NUM_HH_SAMPLES > 0
+
+}  // namespace anu
@@ -0,0 +1,46 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Hi-hat samples, generated by anu/resources/hh_samples.py. Only the first
+// NUM_HH_SAMPLES of them are compiled in, at 4kB of flash each.
+
+#ifndef ANU_HH_SAMPLES_H_
+#define ANU_HH_SAMPLES_H_
+
+#include "avrlib/base.h"
+
+#include <avr/pgmspace.h>
+
+#ifndef NUM_HH_SAMPLES
+#define NUM_HH_SAMPLES 0
+#endif  // NUM_HH_SAMPLES
+
+#if NUM_HH_SAMPLES > 3
+#error "Only 3 hi-hat samples are bundled."
+#endif  // NUM_HH_SAMPLES > 3
+
+namespace anu {
+
+static const uint16_t kHhSampleSize = 4096;
+
+#if NUM_HH_SAMPLES > 0
+extern const prog_uint8_t* hh_sample_table[];
+#endif  // NUM_HH_SAMPLES > 0
+
+}  // namespace anu
+
+#endif  // ANU_HH_SAMPLES_H_
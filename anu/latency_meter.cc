@@ -0,0 +1,103 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Latency histograms.
+
+#include "anu/latency_meter.h"
+
+#include <string.h>
+
+namespace anu {
+
+#ifdef ENABLE_LATENCY_METER
+
+/* <static> */
+bool LatencyMeter::enabled_;
+bool LatencyMeter::pending_[LATENCY_PATH_LAST];
+uint16_t LatencyMeter::stamp_[LATENCY_PATH_LAST];
+uint8_t LatencyMeter::previous_outputs_;
+LatencyReport LatencyMeter::report_;
+
+uint8_t LatencyMeter::midi_status_;
+uint8_t LatencyMeter::midi_data_count_;
+bool LatencyMeter::midi_status_received_;
+uint16_t LatencyMeter::midi_stamp_;
+volatile uint16_t LatencyMeter::note_on_stamps_[kNumNoteOnStamps];
+volatile uint8_t LatencyMeter::note_on_stamps_write_ptr_;
+volatile uint8_t LatencyMeter::note_on_stamps_read_ptr_;
+volatile uint8_t LatencyMeter::note_on_stamps_valid_;
+bool LatencyMeter::note_on_stamp_valid_;
+uint16_t LatencyMeter::note_on_stamp_;
+/* </static> */
+
+/* static */
+void LatencyMeter::Reset() {
+  uint8_t sreg = SREG;
+  cli();
+  memset(&report_, 0, sizeof(report_));
+  for (uint8_t i = 0; i < LATENCY_PATH_LAST; ++i) {
+    report_.path[i].min = 0xffff;
+    pending_[i] = false;
+  }
+  enabled_ = true;
+  SREG = sreg;
+}
+
+/* static */
+const uint8_t* LatencyMeter::Freeze() {
+  enabled_ = false;
+  return static_cast<const uint8_t*>(static_cast<const void*>(&report_));
+}
+
+/* static */
+void LatencyMeter::Record(uint8_t path) {
+  uint8_t sreg = SREG;
+  cli();
+  if (pending_[path] && enabled_) {
+    uint16_t latency = clock.time() - stamp_[path];
+    pending_[path] = false;
+    if (latency >= kLatencyRange) {
+      SREG = sreg;
+      return;
+    }
+    
+    LatencyHistogram* h = &report_.path[path];
+    uint8_t bin = latency >> kLatencyHistogramBinShift;
+    if (h->bin[bin] != 0xffff) {
+      ++h->bin[bin];
+    }
+    if (latency < h->min) {
+      h->min = latency;
+    }
+    if (latency > h->max) {
+      h->max = latency;
+    }
+    // The sum and count stop together, so that their ratio stays the mean.
+    if (h->count != 0xffff) {
+      h->sum += latency;
+      ++h->count;
+    }
+  }
+  SREG = sreg;
+}
+
+#endif  // ENABLE_LATENCY_METER
+
+/* extern */
+LatencyMeter latency_meter;
+
+}  // namespace anu
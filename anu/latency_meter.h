@@ -0,0 +1,212 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// MIDI note on to gate out, and clock in to trig out latency histograms. Only
+// compiled in when ENABLE_LATENCY_METER is defined (make LATENCY_METER=1);
+// otherwise all the probes are empty inline functions.
+//
+// The start of a measurement is stamped when a MIDI note on or clock byte, or
+// a rising edge on the trig input is received; and the measurement ends on the
+// next rising edge of the gate or trig outputs, as written to the output shift
+// register. The MIDI input ISR stamps the first byte of each note on message
+// (its status byte, or its first data byte under running status), so that the
+// time spent in the MIDI input buffer is measured. The stamps are queued until
+// the message is parsed, and only those of note ons with a non-zero velocity on
+// the receive channel start a measurement. Times are counted in audio samples
+// (25.5us). Only one measurement per path is in flight at a time, so notes must
+// be spaced by more than the histogram range.
+
+#ifndef ANU_LATENCY_METER_H_
+#define ANU_LATENCY_METER_H_
+
+#include "avrlib/base.h"
+
+#ifdef ENABLE_LATENCY_METER
+#include <avr/interrupt.h>
+#include <avr/io.h>
+
+#include "anu/clock.h"
+#include "anu/ui.h"
+#endif  // ENABLE_LATENCY_METER
+
+namespace anu {
+
+enum LatencyPath {
+  LATENCY_PATH_NOTE_TO_GATE,
+  LATENCY_PATH_CLOCK_TO_TRIG,
+  LATENCY_PATH_LAST
+};
+
+// 32 bins of 8 samples (204us) each. A start stamp older than the range of the
+// histogram (6.5ms) is dropped: the output edge which ends it is not counted,
+// and the next stamp replaces it.
+static const uint8_t kLatencyHistogramSize = 32;
+static const uint8_t kLatencyHistogramBinShift = 3;
+static const uint16_t kLatencyRange = \
+    kLatencyHistogramSize << kLatencyHistogramBinShift;
+static const uint8_t kNumNoteOnStamps = 4;  // At most 8.
+
+struct LatencyHistogram {
+  uint16_t bin[kLatencyHistogramSize];
+  uint16_t min;
+  uint16_t max;
+  uint16_t count;
+  uint32_t sum;
+};
+
+struct LatencyReport {
+  LatencyHistogram path[LATENCY_PATH_LAST];
+};
+
+class LatencyMeter {
+ public:
+  LatencyMeter() { }
+
+#ifdef ENABLE_LATENCY_METER
+
+  static inline void Stamp(uint8_t path) {
+    Start(path, clock.time());
+  }
+  
+  // Called from the MIDI input ISR with each byte written to the MIDI input
+  // buffer. Follows the running status like the parser does, and queues the
+  // arrival time of each complete note on message. The pointers count the
+  // messages, and a message which arrives while all the stamps are waiting to
+  // be read is not stamped.
+  static inline void StampMidiByte(uint8_t byte) {
+    if (byte >= 0xf8) {
+      return;
+    } else if (byte >= 0x80) {
+      midi_status_ = byte < 0xf0 ? byte : 0;
+      midi_data_count_ = 0;
+      midi_status_received_ = true;
+      midi_stamp_ = clock.time();
+      return;
+    } else if ((midi_status_ & 0xf0) != 0x90) {
+      return;
+    }
+    if (midi_data_count_ == 0) {
+      ++midi_data_count_;
+      if (!midi_status_received_) {
+        midi_stamp_ = clock.time();
+      }
+      midi_status_received_ = false;
+      return;
+    }
+    midi_data_count_ = 0;
+    uint8_t slot = note_on_stamps_write_ptr_ & (kNumNoteOnStamps - 1);
+    if (static_cast<uint8_t>(
+            note_on_stamps_write_ptr_ - note_on_stamps_read_ptr_) < \
+        kNumNoteOnStamps) {
+      note_on_stamps_[slot] = midi_stamp_;
+      note_on_stamps_valid_ |= 1 << slot;
+    }
+    ++note_on_stamps_write_ptr_;
+  }
+  
+  // Called when a note on message is parsed, whatever its channel and velocity,
+  // to keep the queue in step with the messages. The stamp is kept for
+  // StartNoteOn().
+  static inline void ReadNoteOnStamp() {
+    uint8_t sreg = SREG;
+    cli();
+    uint8_t slot = note_on_stamps_read_ptr_ & (kNumNoteOnStamps - 1);
+    uint8_t mask = 1 << slot;
+    note_on_stamp_valid_ = note_on_stamps_valid_ & mask;
+    note_on_stamps_valid_ &= ~mask;
+    note_on_stamp_ = note_on_stamps_[slot];
+    ++note_on_stamps_read_ptr_;
+    SREG = sreg;
+  }
+  
+  // Called when the note on read last is played.
+  static inline void StartNoteOn() {
+    if (note_on_stamp_valid_) {
+      Start(LATENCY_PATH_NOTE_TO_GATE, note_on_stamp_);
+      note_on_stamp_valid_ = false;
+    }
+  }
+  
+  // Called with the byte written to the output shift register.
+  static inline void ProcessOutputs(uint8_t out) {
+    uint8_t rising_edges = out & ~previous_outputs_;
+    previous_outputs_ = out;
+    if (rising_edges & _BV(OUTPUT_GATE)) {
+      Record(LATENCY_PATH_NOTE_TO_GATE);
+    }
+    if (rising_edges & _BV(OUTPUT_TRIG)) {
+      Record(LATENCY_PATH_CLOCK_TO_TRIG);
+    }
+  }
+
+  static void Reset();
+  
+  // Stops the measurements until the next Reset(), so that the report can be
+  // sent straight from the histograms.
+  static const uint8_t* Freeze();
+
+#else
+
+  static inline void Stamp(uint8_t path) { }
+  static inline void StampMidiByte(uint8_t byte) { }
+  static inline void ReadNoteOnStamp() { }
+  static inline void StartNoteOn() { }
+  static inline void ProcessOutputs(uint8_t out) { }
+  static inline void Reset() { }
+
+#endif  // ENABLE_LATENCY_METER
+
+ private:
+#ifdef ENABLE_LATENCY_METER
+  static inline void Start(uint8_t path, uint16_t time) {
+    uint8_t sreg = SREG;
+    cli();
+    if (!pending_[path] || clock.time() - stamp_[path] >= kLatencyRange) {
+      stamp_[path] = time;
+      pending_[path] = true;
+    }
+    SREG = sreg;
+  }
+  
+  static void Record(uint8_t path);
+
+  static bool enabled_;
+  static bool pending_[LATENCY_PATH_LAST];
+  static uint16_t stamp_[LATENCY_PATH_LAST];
+  static uint8_t previous_outputs_;
+  static LatencyReport report_;
+  
+  static uint8_t midi_status_;
+  static uint8_t midi_data_count_;
+  static bool midi_status_received_;
+  static uint16_t midi_stamp_;
+  static volatile uint16_t note_on_stamps_[kNumNoteOnStamps];
+  static volatile uint8_t note_on_stamps_write_ptr_;
+  static volatile uint8_t note_on_stamps_read_ptr_;
+  static volatile uint8_t note_on_stamps_valid_;
+  static bool note_on_stamp_valid_;
+  static uint16_t note_on_stamp_;
+#endif  // ENABLE_LATENCY_METER
+
+  DISALLOW_COPY_AND_ASSIGN(LatencyMeter);
+};
+
+extern LatencyMeter latency_meter;
+
+}  // namespace anu
+
+#endif  // ANU_LATENCY_METER_H_
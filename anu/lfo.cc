@@ -28,7 +28,7 @@ namespace anu {
 using avrlib::Random;
 
 uint16_t Lfo::Render() {
-  uint16_t value;
+  uint16_t value = 0;
   switch (shape_) {
     case LFO_SHAPE_TRIANGLE:
       value = (phase_ & 0x80000000)
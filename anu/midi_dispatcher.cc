@@ -29,34 +29,123 @@ bool MidiDispatcher::learning_midi_channel_ = false;
 /* static */
 bool MidiDispatcher::seen_midi_drum_events_ = false;
 
+/* static */
+uint8_t MidiDispatcher::running_status_ = 0;
+
+/* static */
+volatile uint8_t MidiDispatcher::num_clock_messages_queued_ = 0;
+
+/* static */
+volatile uint8_t MidiDispatcher::num_clock_messages_sent_ = 0;
+
+// Bytes are sent from the UART data register empty interrupt, which is enabled
+// whenever something is queued and disables itself once both buffers are
+// empty.
+static inline void StartTransmission() {
+  UCSR0B |= _BV(UDRIE0);
+}
+
+/* static */
+void MidiDispatcher::Write(uint8_t byte) {
+  // The bytes that follow held messages are held too, so that they are not
+  // reordered.
+  if (sysex_handler.dumping() || HeldOutputBuffer::readable()) {
+    if (!HeldOutputBuffer::writable()) {
+      // Rather than losing a message, complete the SysEx message in progress
+      // and wait for the held messages to fit in the output buffer.
+      sysex_handler.FinishMessage();
+      StartTransmission();
+      while (HeldOutputBuffer::readable()) {
+        OutputBufferLowPriority::Write(HeldOutputBuffer::ImmediateRead());
+      }
+    }
+    HeldOutputBuffer::Overwrite(byte);
+  } else {
+    OutputBufferLowPriority::Overwrite(byte);
+  }
+}
+
+/* static */
+bool MidiDispatcher::ReleaseHeldMessages() {
+  uint8_t size = HeldOutputBuffer::readable();
+  if (size > OutputBufferLowPriority::writable()) {
+    return false;
+  }
+  while (size--) {
+    OutputBufferLowPriority::Overwrite(HeldOutputBuffer::ImmediateRead());
+  }
+  StartTransmission();
+  return true;
+}
+
+/* static */
+void MidiDispatcher::WriteStatus(uint8_t status) {
+  if (status >= 0xf0) {
+    // System common messages cancel running status.
+    running_status_ = 0;
+    Write(status);
+  } else if (status != running_status_) {
+    running_status_ = status;
+    Write(status);
+  }
+}
+
 /* static */
 void MidiDispatcher::Send(uint8_t status, uint8_t* data, uint8_t size) {
-  OutputBufferLowPriority::Overwrite(status);
+  if (status >= 0xf8) {
+    // Realtime messages skip the queue.
+    SendNow(status);
+    return;
+  } else if (status & 0x80) {
+    WriteStatus(status);
+  } else {
+    // SysEx data byte.
+    Write(status);
+  }
   if (size) {
-    OutputBufferLowPriority::Overwrite(*data++);
+    Write(*data++);
     --size;
   }
   if (size) {
-    OutputBufferLowPriority::Overwrite(*data++);
+    Write(*data++);
     --size;
   }
+  StartTransmission();
 }
 
 /* static */
 void MidiDispatcher::SendBlocking(uint8_t byte) {
+  if (byte & 0x80) {
+    running_status_ = 0;
+  }
   OutputBufferLowPriority::Write(byte);
+  StartTransmission();
 }
 
 /* static */
 void MidiDispatcher::SendNow(uint8_t byte) {
   OutputBufferHighPriority::Overwrite(byte);
+  StartTransmission();
+}
+
+/* static */
+void MidiDispatcher::OnClockPulse(bool midi_generated) {
+  // No need to duplicate a MIDI clock message.
+  if (mode() & MIDI_OUT_TX_INPUT_MESSAGES && midi_generated) {
+    return;
+  }
+  if (mode() & MIDI_OUT_TX_TRANSPORT) {
+    ++num_clock_messages_queued_;
+    StartTransmission();
+  }
 }
 
 /* static */
 void MidiDispatcher::Send3(uint8_t status, uint8_t a, uint8_t b) {
-  OutputBufferLowPriority::Overwrite(status);
-  OutputBufferLowPriority::Overwrite(a);
-  OutputBufferLowPriority::Overwrite(b);
+  WriteStatus(status);
+  Write(a);
+  Write(b);
+  StartTransmission();
 }
 
 /* extern */
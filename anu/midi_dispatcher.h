@@ -21,7 +21,10 @@
 #include "avrlib/base.h"
 #include "avrlib/ring_buffer.h"
 
+#include "anu/clock.h"
 #include "anu/drum_synth.h"
+#include "anu/latency_meter.h"
+#include "anu/parameter.h"
 #include "anu/sysex_handler.h"
 #include "anu/system_settings.h"
 #include "anu/voice_controller.h"
@@ -46,20 +49,35 @@ struct HighPriorityBufferSpecs {
   typedef avrlib::DataTypeForSize<data_size>::Type Value;
 };
 
+struct HeldBufferSpecs {
+  enum {
+    buffer_size = 32,
+    data_size = 8,
+  };
+  typedef avrlib::DataTypeForSize<data_size>::Type Value;
+};
+
 class MidiDispatcher : public midi::MidiDevice {
  public:
   typedef avrlib::RingBuffer<LowPriorityBufferSpecs> OutputBufferLowPriority;
   typedef avrlib::RingBuffer<HighPriorityBufferSpecs> OutputBufferHighPriority;
+  typedef avrlib::RingBuffer<HeldBufferSpecs> HeldOutputBuffer;
 
   MidiDispatcher() { }
 
   // ------ MIDI in handling ---------------------------------------------------
 
-  // Forwarded to the controller.
+  // Forwarded to the controller, after the control changes received before
+  // the note.
   static inline void NoteOn(uint8_t channel, uint8_t note, uint8_t velocity) {
+    parameter_manager.FlushQueuedValues();
+    if (velocity) {
+      latency_meter.StartNoteOn();
+    }
     voice_controller.NoteOn(note, velocity);
   }
   static inline void NoteOff(uint8_t channel, uint8_t note, uint8_t velocity) {
+    parameter_manager.FlushQueuedValues();
     voice_controller.NoteOff(note);
   }
 
@@ -94,13 +112,23 @@ class MidiDispatcher : public midi::MidiDevice {
   static void OmniModeOn(uint8_t channel) { }
   
   static void ProgramChange(uint8_t channel, uint8_t program) {
-    // No fucking presets.
+    // No fucking presets. Program changes select one of the sequence slots.
+    voice_controller.SelectSequence(program);
   }
   
   static void Reset() { }
   static void Clock() { 
+    // The arrival time of the message has been recorded by the MIDI input ISR.
+    // If it was received while the stamps were all in use, its arrival time is
+    // unknown and it only gives credit for its ticks.
+    uint16_t time;
+    bool stamped = clock.ReadMidiClockStamp(&time);
     if (!voice_controller.internal_clock()) {
-      voice_controller.Clock(true);
+      if (stamped) {
+        clock.Edge(time, true);
+      } else {
+        clock.Credit();
+      }
     }
   }
   static void Start() {
@@ -124,6 +152,13 @@ class MidiDispatcher : public midi::MidiDevice {
   static void SysExEnd() {
     ProcessSysEx(0xf7);
   }
+  static void RawByte(uint8_t byte) {
+    // Any status byte other than a realtime message or the end of SysEx
+    // terminates a SysEx message before its end.
+    if (byte >= 0x80 && byte < 0xf8 && byte != 0xf0 && byte != 0xf7) {
+      sysex_handler.Abort();
+    }
+  }
   
   static uint8_t CheckChannel(uint8_t channel) {
     return system_settings.receive_channel(channel);
@@ -134,6 +169,9 @@ class MidiDispatcher : public midi::MidiDevice {
       uint8_t* data,
       uint8_t data_size,
       uint8_t accepted_channel) {
+    if ((status & 0xf0) == 0x90) {
+      latency_meter.ReadNoteOnStamp();
+    }
     if (mode() & MIDI_OUT_TX_INPUT_MESSAGES) {
       Send(status, data, data_size);
     }
@@ -188,6 +226,10 @@ class MidiDispatcher : public midi::MidiDevice {
   static uint8_t readable_low_priority() {
     return OutputBufferLowPriority::readable();
   }
+  
+  static uint8_t writable_low_priority() {
+    return OutputBufferLowPriority::writable();
+  }
 
   static uint8_t ImmediateReadHighPriority() {
     return OutputBufferHighPriority::ImmediateRead();
@@ -197,6 +239,16 @@ class MidiDispatcher : public midi::MidiDevice {
     return OutputBufferLowPriority::ImmediateRead();
   }
   
+  // The messages sent while a SysEx dump is in progress are held back, so that
+  // they do not cut into its messages, and are released between two messages
+  // of the dump. Returns false if there is not enough room for them yet in the
+  // output buffer.
+  static bool ReleaseHeldMessages();
+  
+  static uint8_t holding() {
+    return HeldOutputBuffer::readable();
+  }
+  
   static void LearnChannel() {
     learning_midi_channel_ = true;
   }
@@ -218,7 +270,9 @@ class MidiDispatcher : public midi::MidiDevice {
     if (note != 0xff) {
       uint8_t channel = system_settings.midi_channel();
       if (mode() & MIDI_OUT_TX_GENERATED_MESSAGES) {
-        Send3(0x80 | channel, note, 0);
+        // Sent as a note on with a velocity of 0 to benefit from running
+        // status.
+        Send3(0x90 | channel, note, 0);
       }
     }
   }
@@ -234,7 +288,7 @@ class MidiDispatcher : public midi::MidiDevice {
     if (note != 0xff) {
       if (mode() & MIDI_OUT_TX_GENERATED_DRUM_MESSAGES) {
         Send3(0x99, note, velocity);
-        Send3(0x89, note, 0);
+        Send3(0x99, note, 0);
       }
     }
   }
@@ -251,24 +305,36 @@ class MidiDispatcher : public midi::MidiDevice {
     }
   }
   
-  static inline void OnClock(bool midi_generated) {
-    // No need to duplicate a MIDI clock message.
-    if (mode() & MIDI_OUT_TX_INPUT_MESSAGES && midi_generated) {
-      return;
-    }
-    if (mode() & MIDI_OUT_TX_TRANSPORT) {
-      SendNow(0xf8);
-    }
+  // Called from the clock ISR at each clock pulse. The clock message is sent
+  // by the UART ISR ahead of any other byte. Only the clock ISR writes
+  // num_clock_messages_queued_, and only the UART ISR writes
+  // num_clock_messages_sent_, so this does not need to share the output
+  // buffers with the main loop.
+  static void OnClockPulse(bool midi_generated);
+  
+  static inline bool clock_message_pending() {
+    return num_clock_messages_queued_ != num_clock_messages_sent_;
+  }
+  
+  static inline void ClockMessageSent() {
+    ++num_clock_messages_sent_;
   }
   
+  // Channel messages are sent with running status. Realtime messages are
+  // sent ahead of any queued data.
   static void Send3(uint8_t status, uint8_t a, uint8_t b);
   static void SendBlocking(uint8_t byte);
 
  private:
   static bool learning_midi_channel_;
   static bool seen_midi_drum_events_;
+  static uint8_t running_status_;
+  static volatile uint8_t num_clock_messages_queued_;
+  static volatile uint8_t num_clock_messages_sent_;
    
   static void Send(uint8_t status, uint8_t* data, uint8_t size);
+  static void Write(uint8_t byte);
+  static void WriteStatus(uint8_t status);
   static void SendNow(uint8_t byte);
   static inline uint8_t mode() { return system_settings.midi_out_mode(); }
   
@@ -17,26 +17,31 @@
 //
 // Stack of currently pressed keys.
 //
-// Currently pressed keys are stored as a linked list. The linked list is used
-// as a LIFO stack to allow monosynth-like behaviour. An example of such
-// behaviour is:
+// Currently pressed keys are stored as a doubly linked list. The linked list
+// is used as a LIFO stack to allow monosynth-like behaviour. An example of
+// such behaviour is:
 // player presses and holds C4-> C4 is played.
 // player presses and holds C5 (while holding C4) -> C5 is played.
 // player presses and holds G4 (while holding C4&C5)-> G4 is played.
 // player releases C5 -> G4 is played.
 // player releases G4 -> C4 is played.
 //
-// The nodes used in the linked list are pre-allocated from a pool of 16
-// nodes, so the "pointers" (to the root element for example) are not actual
-// pointers, but indices of an element in the pool.
+// The nodes used in the linked list are pre-allocated from a pool of at most
+// 16 nodes, so the "pointers" (to the root element for example) are not actual
+// pointers, but 4-bit indices of an element in the pool. The next and
+// previous pointers of a node are packed in a single byte. The free nodes are
+// chained through the same links, so allocating a node and evicting the least
+// recently played note (the tail of the list) are constant time operations.
 //
 // Additionally, an array of pointers is stored to allow random access to the
-// n-th note, sorted by ascending order of pitch (for arpeggiation).
+// n-th note, sorted by ascending order of pitch (for arpeggiation). A node is
+// removed from it in the same pass which shifts the following nodes down.
 
 #ifndef ANU_NOTE_STACK_H_
 #define ANU_NOTE_STACK_H_
 
 #include "avrlib/base.h"
+#include "avrlib/op.h"
 
 #include <string.h>
 
@@ -47,7 +52,7 @@ static const uint8_t kFreeSlot = 0xff;
 struct NoteEntry {
   uint8_t note;
   uint8_t velocity;
-  uint8_t next_ptr;  // Base 1.
+  uint8_t links;  // Next (older) node in the 4 MSB, previous in the 4 LSB.
 };
 
 // This looks crazy, but we are more concerned about RAM used than code size here.
@@ -55,7 +60,13 @@ template<uint8_t capacity>
 class NoteStack {
  public: 
   NoteStack() { }
-  void Init() { Clear(); }
+  void Init() {
+    STATIC_ASSERT(capacity <= 16);
+    // No more RAM than the previous implementation, with its dummy node: 70
+    // bytes for 16 notes.
+    STATIC_ASSERT(sizeof(NoteStack) <= 4 * capacity + 6);
+    Clear();
+  }
 
   void NoteOn(uint8_t note, uint8_t velocity) {
     // Remove the note from the list first (in case it is already here).
@@ -63,112 +74,115 @@ class NoteStack {
     // In case of saturation, remove the least recently played note from the
     // stack.
     if (size_ == capacity) {
-      uint8_t least_recent_note;
-      for (uint8_t i = 1; i <= capacity; ++i) {
-        if (pool_[i].next_ptr == 0) {
-          least_recent_note = pool_[i].note;
-        }
-      }
-      NoteOff(least_recent_note);
+      Remove(tail_ptr_);
     }
-    // Now we are ready to insert the new note. Find a free slot to insert it.
-    uint8_t free_slot;
-    for (uint8_t i = 1; i <= capacity; ++i) {
-      if (pool_[i].note == kFreeSlot) {
-        free_slot = i;
-        break;
-      }
+    // Now we are ready to insert the new note, at the root of the list.
+    uint8_t slot = free_ptr_;
+    free_ptr_ = next(slot);
+    if (size_) {
+      set_prev(root_ptr_, slot);
+    } else {
+      tail_ptr_ = slot;
     }
-    pool_[free_slot].next_ptr = root_ptr_;
-    pool_[free_slot].note = note;
-    pool_[free_slot].velocity = velocity;
-    root_ptr_ = free_slot;
+    pool_[slot].links = root_ptr_ << 4;
+    pool_[slot].note = note;
+    pool_[slot].velocity = velocity;
+    root_ptr_ = slot;
     // The last step consists in inserting the note in the sorted list.
-    for (uint8_t i = 0; i < size_; ++i) {
-      if (pool_[sorted_ptr_[i]].note > note) {
-        for (uint8_t j = size_; j > i; --j) {
-          sorted_ptr_[j] = sorted_ptr_[j - 1];
-        }
-        sorted_ptr_[i] = free_slot;
-        free_slot = 0;
-        break;
-      }
-    }
-    if (free_slot) {
-      sorted_ptr_[size_] = free_slot;
+    uint8_t i = size_;
+    while (i && pool_[sorted_ptr_[i - 1]].note > note) {
+      sorted_ptr_[i] = sorted_ptr_[i - 1];
+      --i;
     }
+    sorted_ptr_[i] = slot;
     ++size_;
   }
   
   void NoteOff(uint8_t note) {
-    uint8_t current = root_ptr_;
-    uint8_t previous = 0;
-    while (current) {
-     if (pool_[current].note == note) {
-       break;
-     }
-     previous = current;
-     current = pool_[current].next_ptr;
-    }
-    if (current) {
-     if (previous) {
-       pool_[previous].next_ptr = pool_[current].next_ptr;
-     } else {
-       root_ptr_ = pool_[current].next_ptr;
-     }
-     for (uint8_t i = 0; i < size_; ++i) {
-       if (sorted_ptr_[i] == current) {
-         for (uint8_t j = i; j < size_ - 1; ++j) {
-           sorted_ptr_[j] = sorted_ptr_[j + 1];
-         }
-         break;
-       }
-     }
-     pool_[current].next_ptr = 0;
-     pool_[current].note = kFreeSlot;
-     pool_[current].velocity = 0;
-     --size_;
+    for (uint8_t i = 0; i < size_; ++i) {
+      uint8_t slot = sorted_ptr_[i];
+      if (pool_[slot].note == note) {
+        Remove(slot);
+        break;
+      }
     }
   }
   
   void Clear() {
     size_ = 0;
-    memset(pool_ + 1, 0, sizeof(NoteEntry) * capacity);
-    memset(sorted_ptr_ + 1, 0, capacity);
-    root_ptr_ = 0;
-    for (uint8_t i = 0; i <= capacity; ++i) {
+    root_ptr_ = tail_ptr_ = free_ptr_ = 0;
+    for (uint8_t i = 0; i < capacity; ++i) {
       pool_[i].note = kFreeSlot;
+      pool_[i].velocity = 0;
+      pool_[i].links = (i + 1) << 4;
     }
   }
 
   uint8_t size() const { return size_; }
+  // When the stack is empty, the root and tail pointers point to a free node,
+  // with a note of kFreeSlot.
   const NoteEntry& most_recent_note() const { return pool_[root_ptr_]; }
-  const NoteEntry& least_recent_note() const {
-    uint8_t current = root_ptr_;
-    while (current && pool_[current].next_ptr) {
-      current = pool_[current].next_ptr;
-    }
-    return pool_[current];
-  }
+  const NoteEntry& least_recent_note() const { return pool_[tail_ptr_]; }
   const NoteEntry& played_note(uint8_t index) const {
-    uint8_t current = root_ptr_;
-    index = size_ - index - 1;
+    uint8_t current = tail_ptr_;
     for (uint8_t i = 0; i < index; ++i) {
-      current = pool_[current].next_ptr;
+      current = prev(current);
     }
     return pool_[current];
   }
   const NoteEntry& sorted_note(uint8_t index) const {
     return pool_[sorted_ptr_[index]];
   }
-  const NoteEntry& note(uint8_t index) const { return pool_[index]; }
-  const NoteEntry& dummy() const { return pool_[0]; }
 
  private:
+  inline uint8_t next(uint8_t slot) const {
+    return avrlib::U8ShiftRight4(pool_[slot].links);
+  }
+  inline uint8_t prev(uint8_t slot) const {
+    return pool_[slot].links & 0x0f;
+  }
+  inline void set_next(uint8_t slot, uint8_t next) {
+    pool_[slot].links = (pool_[slot].links & 0x0f) | (next << 4);
+  }
+  inline void set_prev(uint8_t slot, uint8_t prev) {
+    pool_[slot].links = (pool_[slot].links & 0xf0) | prev;
+  }
+  
+  void Remove(uint8_t slot) {
+    uint8_t n = next(slot);
+    uint8_t p = prev(slot);
+    if (slot == root_ptr_) {
+      root_ptr_ = n;
+    } else {
+      set_next(p, n);
+    }
+    if (slot == tail_ptr_) {
+      tail_ptr_ = p;
+    } else {
+      set_prev(n, p);
+    }
+    uint8_t j = 0;
+    for (uint8_t i = 0; i < size_; ++i) {
+      if (sorted_ptr_[i] != slot) {
+        sorted_ptr_[j++] = sorted_ptr_[i];
+      }
+    }
+    --size_;
+    pool_[slot].note = kFreeSlot;
+    pool_[slot].velocity = 0;
+    pool_[slot].links = free_ptr_ << 4;
+    free_ptr_ = slot;
+    if (!size_) {
+      root_ptr_ = tail_ptr_ = slot;
+    }
+  }
+  
   uint8_t size_;
-  NoteEntry pool_[capacity + 1];  // First element is a dummy node!
-  uint8_t root_ptr_;  // Base 1.
-  uint8_t sorted_ptr_[capacity + 1];  // Base 1.
+  NoteEntry pool_[capacity];
+  uint8_t root_ptr_;  // Most recently played note.
+  uint8_t tail_ptr_;  // Least recently played note.
+  uint8_t free_ptr_;  // Head of the chain of free nodes.
+  uint8_t sorted_ptr_[capacity];
 
   DISALLOW_COPY_AND_ASSIGN(NoteStack);
 };
@@ -256,18 +256,65 @@ static const prog_Parameter parameters[PARAMETER_LAST] PROGMEM = {
 };
 
 /* static */
-Parameter ParameterManager::cached_definition_;
+Parameter ParameterManager::cached_definition_[kNumCachedParameters];
 
 /* static */
-uint8_t ParameterManager::cached_index_ = 0xff;
+uint8_t ParameterManager::cached_index_[kNumCachedParameters] = {
+  0xff, 0xff, 0xff, 0xff
+};
+
+/* static */
+uint8_t ParameterManager::next_cache_entry_;
+
+/* static */
+uint8_t ParameterManager::queued_value_[PARAMETER_LAST];
+
+/* static */
+bool ParameterManager::has_queued_values_;
+
+/* static */
+const Parameter* ParameterManager::cached_parameter(uint8_t index) {
+  for (uint8_t i = 0; i < kNumCachedParameters; ++i) {
+    if (cached_index_[i] == index) {
+      return &cached_definition_[i];
+    }
+  }
+  return NULL;
+}
 
 /* static */
 const Parameter& ParameterManager::parameter(uint8_t index) {
-  if (index != cached_index_) {
-    ResourcesManager::Load(parameters, index, &cached_definition_);
-    cached_index_ = index;
+  const Parameter* cached = cached_parameter(index);
+  if (cached) {
+    return *cached;
+  }
+  // Miss: replace the entries in a round-robin fashion.
+  uint8_t entry = next_cache_entry_;
+  next_cache_entry_ = (entry + 1) & (kNumCachedParameters - 1);
+  ResourcesManager::Load(parameters, index, &cached_definition_[entry]);
+  cached_index_[entry] = index;
+  return cached_definition_[entry];
+}
+
+/* static */
+void ParameterManager::ApplyQueuedValues() {
+  has_queued_values_ = false;
+  for (uint8_t i = 0; i < PARAMETER_LAST; ++i) {
+    uint8_t value = queued_value_[i];
+    if (value != kNoQueuedValue) {
+      // A batch can hold more parameters than the cache. The definitions
+      // which are not cached are loaded into a local copy, so that the flush
+      // does not evict those used by the UI.
+      Parameter definition;
+      const Parameter* p = cached_parameter(i);
+      if (!p) {
+        ResourcesManager::Load(parameters, i, &definition);
+        p = &definition;
+      }
+      SetValue(*p, p->Scale(value));
+      queued_value_[i] = kNoQueuedValue;
+    }
   }
-  return cached_definition_;
 }
 
 /* static */
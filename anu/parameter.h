@@ -18,6 +18,8 @@
 
 #include "avrlib/base.h"
 
+#include <string.h>
+
 namespace anu {
 
 enum ParameterDomain {
@@ -90,6 +92,10 @@ enum Parameters {
   PARAMETER_LAST
 };
 
+// Number of parameter definitions kept in RAM, enough for two pots moved at
+// once while CCs are received. Must be a power of 2.
+const uint8_t kNumCachedParameters = 4;
+
 struct Parameter {
   uint8_t domain;
   uint8_t offset;
@@ -115,20 +121,59 @@ class ParameterManager {
   static void SetScaled(uint8_t index, uint8_t value_8bit) {
     const Parameter& p = parameter(index);
     SetValue(p, p.Scale(value_8bit));
+    queued_value_[index] = kNoQueuedValue;
+  }
+  
+  // Dense CC streams only keep the latest value received for each parameter,
+  // and the queued values are applied in one batch by FlushQueuedValues(),
+  // which is called before each voice refresh and before each note event.
+  // They are discarded when a whole patch is loaded or received. The MIDI
+  // values are 7-bit and doubled, so they never collide with kNoQueuedValue.
+  static inline void QueueScaled(uint8_t index, uint8_t value_8bit) {
+    queued_value_[index] = value_8bit;
+    has_queued_values_ = true;
+  }
+  
+  static inline void FlushQueuedValues() {
+    if (has_queued_values_) {
+      ApplyQueuedValues();
+    }
+  }
+  
+  static inline void DiscardQueuedValues() {
+    if (has_queued_values_) {
+      memset(queued_value_, kNoQueuedValue, sizeof(queued_value_));
+      has_queued_values_ = false;
+    }
   }
 
   static uint8_t GetScaled(uint8_t index) {
+    if (queued_value_[index] != kNoQueuedValue) {
+      return queued_value_[index];
+    }
     const Parameter& p = parameter(index);
     return p.Unscale(GetValue(p));
   }
   
   static uint8_t LookupCCMap(uint8_t cc);
   
-  static void Init() { }
+  static void Init() {
+    memset(queued_value_, kNoQueuedValue, sizeof(queued_value_));
+    has_queued_values_ = false;
+  }
   
  private:
-  static Parameter cached_definition_;
-  static uint8_t cached_index_;
+  static const uint8_t kNoQueuedValue = 0xff;
+  
+  static void ApplyQueuedValues();
+  static const Parameter* cached_parameter(uint8_t index);
+  
+  static Parameter cached_definition_[kNumCachedParameters];
+  static uint8_t cached_index_[kNumCachedParameters];
+  static uint8_t next_cache_entry_;
+  
+  static uint8_t queued_value_[PARAMETER_LAST];
+  static bool has_queued_values_;
   
   DISALLOW_COPY_AND_ASSIGN(ParameterManager);
 };
@@ -0,0 +1,64 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Cycle budget profiler.
+
+#include "anu/profiler.h"
+
+namespace anu {
+
+#ifdef ENABLE_PROFILER
+
+/* <static> */
+volatile uint16_t Profiler::ticks_;
+ProfilerStageStats Profiler::stats_[PROFILER_STAGE_LAST];
+/* </static> */
+
+/* static */
+void Profiler::Reset() {
+  uint8_t sreg = SREG;
+  cli();
+  for (uint8_t i = 0; i < PROFILER_STAGE_LAST; ++i) {
+    stats_[i].min = 0xffff;
+    stats_[i].max = 0;
+    stats_[i].sum = 0;
+    stats_[i].count = 0;
+  }
+  SREG = sreg;
+}
+
+/* static */
+void Profiler::Report(ProfilerReport* report) {
+  uint8_t sreg = SREG;
+  cli();
+  for (uint8_t i = 0; i < PROFILER_STAGE_LAST; ++i) {
+    const ProfilerStageStats& s = stats_[i];
+    report->stage[i].min = s.count ? s.min : 0;
+    report->stage[i].avg = s.count ? s.sum / s.count : 0;
+    report->stage[i].max = s.max;
+  }
+  SREG = sreg;
+  // Each report covers the interval since the previous one.
+  Reset();
+}
+
+#endif  // ENABLE_PROFILER
+
+/* extern */
+Profiler profiler;
+
+}  // namespace anu
@@ -0,0 +1,143 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Cycle budget profiler for the ISRs and the main loop stages. Only compiled
+// in when ENABLE_PROFILER is defined (make PROFILER=1); otherwise all the
+// probes are empty inline functions.
+//
+// ISR durations are measured with the counter of the timer triggering them,
+// and are expressed in CPU cycles. Since both timers run in phase correct
+// mode and interrupt at BOTTOM, this is only accurate for ISRs shorter than
+// half their period - anything longer has already blown its budget.
+//
+// Main loop stages are measured in audio samples (510 CPU cycles, 25.5us),
+// which makes them directly comparable to the depth of the audio buffer.
+
+#ifndef ANU_PROFILER_H_
+#define ANU_PROFILER_H_
+
+#include "avrlib/base.h"
+
+#ifdef ENABLE_PROFILER
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#endif  // ENABLE_PROFILER
+
+namespace anu {
+
+enum ProfilerStage {
+  PROFILER_STAGE_DAC_ISR,
+  PROFILER_STAGE_AUDIO_ISR,
+  PROFILER_STAGE_VOICE_REFRESH,
+  PROFILER_STAGE_DRUM_RENDER,
+  PROFILER_STAGE_MIDI_PARSE,
+  PROFILER_STAGE_UI,
+  PROFILER_STAGE_LAST
+};
+
+struct ProfilerStageStats {
+  uint16_t min;
+  uint16_t max;
+  uint32_t sum;
+  uint16_t count;
+};
+
+struct ProfilerStageReport {
+  uint16_t min;
+  uint16_t avg;
+  uint16_t max;
+};
+
+struct ProfilerReport {
+  ProfilerStageReport stage[PROFILER_STAGE_LAST];
+};
+
+// Prescaler values of the DAC (Timer0) and audio (Timer2) timers.
+static const uint8_t kDacTimerPrescaler = 8;
+static const uint8_t kAudioTimerPrescaler = 1;
+
+class Profiler {
+ public:
+  Profiler() { }
+
+#ifdef ENABLE_PROFILER
+
+  static inline void Tick() {
+    ++ticks_;
+  }
+
+  static inline uint8_t dac_timer_value() { return TCNT0; }
+  static inline uint8_t audio_timer_value() { return TCNT2; }
+
+  static inline uint16_t ticks() {
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t ticks = ticks_;
+    SREG = sreg;
+    return ticks;
+  }
+
+  static inline void Record(uint8_t stage, uint16_t duration) {
+    ProfilerStageStats* s = &stats_[stage];
+    if (duration < s->min) {
+      s->min = duration;
+    }
+    if (duration > s->max) {
+      s->max = duration;
+    }
+    s->sum += duration;
+    ++s->count;
+    if (!s->count) {
+      // Avoid an overflow of the average by restarting the accumulation.
+      s->sum = duration;
+      s->count = 1;
+    }
+  }
+
+  static inline void RecordSince(uint8_t stage, uint16_t start_ticks) {
+    Record(stage, ticks() - start_ticks);
+  }
+
+  static void Reset();
+  static void Report(ProfilerReport* report);
+
+#else
+
+  static inline void Tick() { }
+  static inline uint8_t dac_timer_value() { return 0; }
+  static inline uint8_t audio_timer_value() { return 0; }
+  static inline uint16_t ticks() { return 0; }
+  static inline void Record(uint8_t stage, uint16_t duration) { }
+  static inline void RecordSince(uint8_t stage, uint16_t start_ticks) { }
+  static inline void Reset() { }
+
+#endif  // ENABLE_PROFILER
+
+ private:
+#ifdef ENABLE_PROFILER
+  static volatile uint16_t ticks_;
+  static ProfilerStageStats stats_[PROFILER_STAGE_LAST];
+#endif  // ENABLE_PROFILER
+
+  DISALLOW_COPY_AND_ASSIGN(Profiler);
+};
+
+extern Profiler profiler;
+
+}  // namespace anu
+
+#endif  // ANU_PROFILER_H_
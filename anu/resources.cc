@@ -21,7 +21,7 @@
 // make resources
 
 
-#include "anu\resources.h"
+#include "anu/resources.h"
 
 namespace anu {
 
@@ -150,41 +150,6 @@ const prog_uint16_t lut_res_dco_pitch[] PROGMEM = {
    32141,  31910,  31680,  31452,  31226,  31002,  30779,  30557,
    30337,
 };
-const prog_uint16_t lut_res_env_expo[] PROGMEM = {
-       0,   1035,   2054,   3057,   4045,   5018,   5975,   6918,
-    7846,   8760,   9659,  10545,  11416,  12275,  13120,  13952,
-   14771,  15577,  16371,  17152,  17921,  18679,  19425,  20159,
-   20881,  21593,  22294,  22983,  23662,  24331,  24989,  25637,
-   26274,  26902,  27520,  28129,  28728,  29318,  29899,  30471,
-   31034,  31588,  32133,  32670,  33199,  33720,  34232,  34737,
-   35233,  35722,  36204,  36678,  37145,  37604,  38056,  38502,
-   38940,  39371,  39796,  40215,  40626,  41032,  41431,  41824,
-   42211,  42592,  42967,  43336,  43699,  44057,  44409,  44756,
-   45097,  45434,  45764,  46090,  46411,  46727,  47037,  47344,
-   47645,  47941,  48233,  48521,  48804,  49083,  49357,  49627,
-   49893,  50155,  50412,  50666,  50916,  51162,  51404,  51642,
-   51877,  52108,  52335,  52559,  52780,  52997,  53210,  53421,
-   53628,  53831,  54032,  54230,  54424,  54616,  54804,  54990,
-   55173,  55353,  55530,  55704,  55876,  56045,  56211,  56375,
-   56536,  56695,  56851,  57005,  57157,  57306,  57453,  57597,
-   57740,  57880,  58018,  58153,  58287,  58419,  58548,  58676,
-   58801,  58925,  59047,  59167,  59285,  59401,  59515,  59628,
-   59739,  59848,  59955,  60061,  60165,  60267,  60368,  60468,
-   60566,  60662,  60757,  60850,  60942,  61032,  61121,  61209,
-   61295,  61380,  61464,  61546,  61628,  61707,  61786,  61863,
-   61939,  62014,  62088,  62161,  62233,  62303,  62372,  62441,
-   62508,  62574,  62639,  62703,  62767,  62829,  62890,  62950,
-   63010,  63068,  63125,  63182,  63238,  63293,  63347,  63400,
-   63452,  63504,  63554,  63604,  63654,  63702,  63750,  63797,
-   63843,  63888,  63933,  63977,  64021,  64063,  64105,  64147,
-   64188,  64228,  64267,  64306,  64344,  64382,  64419,  64456,
-   64492,  64527,  64562,  64596,  64630,  64664,  64696,  64729,
-   64760,  64792,  64822,  64853,  64883,  64912,  64941,  64969,
-   64997,  65025,  65052,  65079,  65105,  65131,  65157,  65182,
-   65206,  65231,  65255,  65278,  65302,  65324,  65347,  65369,
-   65391,  65412,  65434,  65454,  65475,  65495,  65515,  65535,
-   65535,
-};
 const prog_uint16_t lut_res_groove_swing[] PROGMEM = {
      127,    127,   -127,   -127,    127,    127,   -127,   -127,
      127,    127,   -127,   -127,    127,    127,   -127,   -127,
@@ -212,6 +177,41 @@ const prog_uint16_t lut_res_groove_monkey[] PROGMEM = {
 const prog_uint16_t lut_res_arpeggiator_patterns[] PROGMEM = {
    21845,  62965,  30583,  21065,  27499,  28527,
 };
+const prog_uint16_t lut_res_log2[] PROGMEM = {
+       0,    369,    736,   1102,   1466,   1829,   2190,   2551,
+    2909,   3267,   3623,   3978,   4331,   4683,   5034,   5384,
+    5732,   6079,   6425,   6769,   7112,   7454,   7795,   8134,
+    8473,   8810,   9146,   9480,   9814,  10146,  10477,  10807,
+   11136,  11464,  11791,  12116,  12440,  12764,  13086,  13407,
+   13727,  14046,  14363,  14680,  14996,  15310,  15624,  15937,
+   16248,  16559,  16868,  17177,  17484,  17791,  18096,  18401,
+   18704,  19007,  19308,  19609,  19909,  20207,  20505,  20802,
+   21098,  21393,  21687,  21980,  22272,  22564,  22854,  23144,
+   23433,  23720,  24007,  24293,  24579,  24863,  25146,  25429,
+   25711,  25992,  26272,  26551,  26830,  27108,  27384,  27660,
+   27936,  28210,  28484,  28757,  29029,  29300,  29571,  29840,
+   30109,  30378,  30645,  30912,  31178,  31443,  31707,  31971,
+   32234,  32496,  32758,  33019,  33279,  33538,  33797,  34055,
+   34312,  34569,  34825,  35080,  35334,  35588,  35841,  36094,
+   36346,  36597,  36847,  37097,  37346,  37595,  37842,  38090,
+   38336,  38582,  38827,  39072,  39316,  39559,  39802,  40044,
+   40286,  40527,  40767,  41006,  41246,  41484,  41722,  41959,
+   42196,  42432,  42667,  42902,  43137,  43370,  43603,  43836,
+   44068,  44300,  44530,  44761,  44990,  45220,  45448,  45676,
+   45904,  46131,  46357,  46583,  46809,  47034,  47258,  47482,
+   47705,  47928,  48150,  48372,  48593,  48813,  49034,  49253,
+   49472,  49691,  49909,  50127,  50344,  50560,  50776,  50992,
+   51207,  51422,  51636,  51850,  52063,  52276,  52488,  52700,
+   52911,  53122,  53332,  53542,  53751,  53960,  54169,  54377,
+   54584,  54791,  54998,  55204,  55410,  55615,  55820,  56025,
+   56229,  56432,  56635,  56838,  57040,  57242,  57443,  57644,
+   57845,  58045,  58245,  58444,  58643,  58841,  59039,  59237,
+   59434,  59631,  59827,  60023,  60219,  60414,  60609,  60803,
+   60997,  61190,  61384,  61576,  61769,  61961,  62152,  62343,
+   62534,  62725,  62915,  63104,  63294,  63483,  63671,  63859,
+   64047,  64234,  64421,  64608,  64794,  64980,  65166,  65351,
+   65535,
+};
 
 
 const prog_uint16_t* lookup_table_table[] = {
@@ -219,7 +219,6 @@ const prog_uint16_t* lookup_table_table[] = {
   lut_res_drm_env_increments,
   lut_res_drm_phase_increments,
   lut_res_dco_pitch,
-  lut_res_env_expo,
   lut_res_groove_swing,
   lut_res_groove_shuffle,
   lut_res_groove_push,
@@ -227,81 +226,87 @@ const prog_uint16_t* lookup_table_table[] = {
   lut_res_groove_human,
   lut_res_groove_monkey,
   lut_res_arpeggiator_patterns,
+  lut_res_log2,
 };
 
-const prog_uint32_t lut_res_lfo_increments[] PROGMEM = {
-       0,      0, 116048, 119454, 122961, 126570, 130286, 134110,
-  138047, 142100, 146271, 150565, 154985, 159534, 164217, 169038,
-  174000, 179108, 184365, 189778, 195348, 201083, 206986, 213062,
-  219316, 225754, 232381, 239203, 246225, 253453, 260893, 268551,
-  276435, 284549, 292902, 301501, 310351, 319461, 328839, 338492,
-  348429, 358657, 369185, 380023, 391178, 402661, 414482, 426649,
-  439173, 452065, 465335, 478995, 493056, 507530, 522428, 537764,
-  553550, 569800, 586526, 603744, 621467, 639710, 658489, 677819,
-  697716, 718197, 739280, 760982, 783320, 806315, 829984, 854348,
-  879428, 905243, 931817, 959170, 987327, 1016310, 1046143, 1076853,
-  1108464, 1141003, 1174497, 1208974, 1244464, 1280995, 1318599, 1357306,
-  1397150, 1438163, 1480381, 1523837, 1568569, 1614615, 1662012, 1710800,
-  1761021, 1812715, 1865928, 1920702, 1977084, 2035122, 2094863, 2156357,
-  2219657, 2284815, 2351886, 2420926, 2491992, 2565144, 2640444, 2717954,
-  2797740, 2879867, 2964406, 3051426, 3141001, 3233205, 3328116, 3425812,
-  3526377, 3629894, 3736449, 3846133, 3959036, 4075254, 4194883, 4318023,
-  4444779, 4575255, 4709562, 4847811, 4990119, 5136604, 5287389, 5442600,
-  5602367, 5766825, 5936110, 6110365, 6289734, 6474369, 6664425, 6860059,
-  7061436, 7268724, 7482098, 7701735, 7927819, 8160540, 8400093, 8646677,
-  8900501, 9161775, 9430719, 9707557, 9992523, 10285853, 10587794, 10898599,
-  11218527, 11547847, 11886834, 12235772, 12594953, 12964678, 13345256, 13737006,
-  14140256, 14555343, 14982615, 15422429, 15875155, 16341170, 16820865, 17314641,
-  17822913, 18346104, 18884654, 19439013, 20009645, 20597028, 21201654, 21824028,
-  22464672, 23124123, 23802931, 24501666, 25220913, 25961272, 26723365, 27507830,
-  28315322, 29146518, 30002114, 30882826, 31789391, 32722569, 33683139, 34671908,
-  35689702, 36737373, 37815798, 38925881, 40068550, 41244762, 42455502, 43701783,
-  44984648, 46305172, 47664461, 49063651, 50503914, 51986456, 53512518, 55083378,
-  56700350, 58364789, 60078087, 61841679, 63657041, 65525693, 67449200, 69429170,
-  71467263, 73565185, 75724690, 77947588, 80235739, 82591059, 85015519, 87511149,
-  90080039, 92724338, 95446261, 98248085, 101132157, 104100891, 107156772, 110302359,
-  113540284, 116873259, 120304073, 123835598, 127470791, 131212696, 135064444, 139029260,
-  143110463, 147311470, 151635798, 156087066, 160669001, 165385439, 170240328, 175237732,
-};
-const prog_uint32_t lut_res_env_increments[] PROGMEM = {
-  1431655765, 1309980816, 1200277497, 1101212141, 1011616508, 930465241, 856856652, 789996321,
-  729183068, 673796913, 623288734, 577171355, 535011856, 496424925, 461067093, 428631730,
-  398844697, 371460552, 346259245, 323043219, 301634880, 281874373, 263617632, 246734655,
-  231107998, 216631433, 203208767, 190752798, 179184389, 168431643, 158429172, 149117451,
-  140442233, 132354037, 124807681, 117761874, 111178844, 105024009, 99265676, 93874778,
-  88824631, 84090722, 79650508, 75483248, 71569838, 67892673, 64435514, 61183370,
-  58122396, 55239793, 52523723, 49963226, 47548151, 45269088, 43117310, 41084717,
-  39163787, 37347528, 35629442, 34003479, 32464011, 31005791, 29623932, 28313875,
-  27071368, 25892437, 24773375, 23710715, 22701215, 21741841, 20829757, 19962302,
-  19136986, 18351474, 17603577, 16891239, 16212531, 15565643, 14948873, 14360619,
-  13799379, 13263735, 12752357, 12263990, 11797451, 11351628, 10925470, 10517988,
-  10128246, 9755365, 9398510, 9056895, 8729779, 8416457, 8116265, 7828577,
-  7552796, 7288360, 7034737, 6791420, 6557933, 6333821, 6118655, 5912026,
-  5713548, 5522854, 5339594, 5163438, 4994072, 4831195, 4674525, 4523791,
-  4378736, 4239115, 4104696, 3975258, 3850590, 3730490, 3614768, 3503241,
-  3395735, 3292085, 3192133, 3095727, 3002725, 2912988, 2826386, 2742794,
-  2662091, 2584164, 2508904, 2436206, 2365971, 2298103, 2232511, 2169108,
-  2107810, 2048538, 1991214, 1935766, 1882124, 1830219, 1779988, 1731370,
-  1684304, 1638735, 1594607, 1551869, 1510471, 1470364, 1431503, 1393843,
-  1357341, 1321958, 1287654, 1254391, 1222133, 1190845, 1160494, 1131048,
-  1102477, 1074749, 1047837, 1021714, 996353, 971728, 947815, 924590,
-  902031, 880117, 858825, 838136, 818030, 798488, 779493, 761026,
-  743072, 725613, 708634, 692120, 676056, 660429, 645224, 630429,
-  616031, 602018, 588378, 575099, 562172, 549584, 537326, 525389,
-  513761, 502435, 491401, 480651, 470176, 459968, 450020, 440324,
-  430872, 421657, 412674, 403914, 395372, 387042, 378916, 370991,
-  363260, 355717, 348358, 341177, 334169, 327330, 320655, 314139,
-  307778, 301567, 295504, 289583, 283802, 278155, 272640, 267253,
-  261991, 256850, 251827, 246919, 242123, 237436, 232855, 228378,
-  224002, 219724, 215542, 211452, 207454, 203544, 199721, 195982,
-  192324, 188747, 185247, 181824, 178474, 175197, 171991, 168853,
-  165782, 162776, 159835, 156955, 154137, 151377, 148676, 146031,
+const prog_uint32_t lut_res_env_coefficients[] PROGMEM = {
+  3162826208, 3026982032, 2890583802, 2754847482, 2620822190, 2489389486, 2361269749, 2237033365,
+  2117114820, 2001828195, 1891383018, 1785899649, 1685423744, 1589939463, 1499381285, 1413644380,
+  1332593601, 1256071139, 1183902986, 1115904298, 1051883818, 991647458, 935001181, 881753236,
+  831715943, 784706986, 740550390, 699077197, 660125911, 623542738, 589181687, 556904559,
+  526580822, 498087442, 471308630, 446135590, 422466210, 400204762, 379261567, 359552686,
+  340999591, 323528869, 307071889, 291564542, 276946930, 263163121, 250160878, 237891417,
+  226309190, 215371660, 205039108, 195274428, 186042964, 177312334, 169052282, 161234529,
+  153832639, 146821887, 140179158, 133882813, 127912615, 122249606, 116876042, 111775302,
+  106931816, 102330974, 97959098, 93803350, 89851684, 86092790, 82516066, 79111535,
+  75869833, 72782159, 69840242, 67036293, 64362990, 61813446, 59381174, 57060054,
+  54844340, 52728596, 50707715, 48776872, 46931508, 45167336, 43480296, 41866562,
+  40322511, 38844733, 37429988, 36075221, 34777550, 33534228, 32342669, 31200430,
+  30105179, 29054719, 28046971, 27079949, 26151789, 25260706, 24405019, 23583120,
+  22793494, 22034699, 21305358, 20604171, 19929904, 19281370, 18657458, 18057099,
+  17479279, 16923032, 16387441, 15871634, 15374775, 14896068, 14434761, 13990129,
+  13561484, 13148174, 12749571, 12365074, 11994121, 11636161, 11290677, 10957175,
+  10635175, 10324227, 10023901, 9733777, 9453465, 9182582, 8920767, 8667674,
+  8422970, 8186340, 7957475, 7736089, 7521902, 7314640, 7114054, 6919899,
+  6731935, 6549940, 6373694, 6202992, 6037636, 5877431, 5722197, 5571755,
+  5425934, 5284578, 5147529, 5014634, 4885751, 4760740, 4639468, 4521810,
+  4407645, 4296845, 4189304, 4084912, 3983563, 3885154, 3789587, 3696768,
+  3606609, 3519026, 3433927, 3351236, 3270874, 3192765, 3116841, 3043025,
+  2971260, 2901472, 2833601, 2767588, 2703373, 2640904, 2580121, 2520976,
+  2463417, 2407397, 2352867, 2299780, 2248099, 2197773, 2148766, 2101042,
+  2054552, 2009270, 1965154, 1922174, 1880292, 1839478, 1799703, 1760935,
+  1723142, 1686297, 1650379, 1615352, 1581197, 1547889, 1515397, 1483708,
+  1452794, 1422632, 1393206, 1364491, 1336468, 1309120, 1282429, 1256372,
+  1230936, 1206099, 1181853, 1158176, 1135058, 1112476, 1090422, 1068879,
+  1047836, 1027277, 1007190, 987562, 968383, 949639, 931319, 913415,
+  895915, 878806, 862081, 845725, 829736, 814099, 798810, 783856,
+  769227, 754922, 740924, 727234, 713837, 700731, 687909, 675359,
+  663077, 651055, 639292, 627774, 616504, 605465, 594663, 584084,
 };
 
 
 const prog_uint32_t* lookup_table_32_table[] = {
+  lut_res_env_coefficients,
+};
+
+const prog_uint16_t lut_res_lfo_increments[] PROGMEM = {
+       0,      0,  19541,  19754,  19973,  20199,  20431,  20575,
+   20698,  20825,  20955,  21089,  21227,  21369,  21516,  21666,
+   21822,  21981,  22145,  22315,  22489,  22668,  22852,  23042,
+   23238,  23439,  23646,  23859,  24079,  24304,  24537,  24676,
+   24799,  24926,  25057,  25191,  25329,  25472,  25618,  25769,
+   25924,  26084,  26249,  26418,  26592,  26772,  26956,  27146,
+   27342,  27544,  27751,  27964,  28184,  28410,  28643,  28777,
+   28901,  29028,  29158,  29293,  29431,  29574,  29720,  29871,
+   30027,  30187,  30352,  30521,  30696,  30875,  31060,  31251,
+   31447,  31648,  31856,  32070,  32289,  32516,  32749,  32878,
+   33002,  33129,  33260,  33395,  33533,  33676,  33823,  33974,
+   34130,  34290,  34455,  34624,  34799,  34979,  35164,  35355,
+   35551,  35753,  35961,  36175,  36395,  36622,  36855,  36980,
+   37103,  37231,  37362,  37496,  37635,  37778,  37925,  38077,
+   38232,  38393,  38558,  38728,  38903,  39083,  39268,  39459,
+   39655,  39858,  40066,  40280,  40500,  40727,  40961,  41081,
+   41205,  41332,  41463,  41598,  41737,  41880,  42027,  42179,
+   42335,  42496,  42661,  42831,  43006,  43187,  43372,  43563,
+   43760,  43962,  44171,  44385,  44606,  44833,  45062,  45182,
+   45306,  45434,  45565,  45700,  45839,  45982,  46130,  46282,
+   46438,  46599,  46764,  46934,  47110,  47290,  47476,  47668,
+   47864,  48067,  48276,  48490,  48712,  48939,  49163,  49283,
+   49407,  49535,  49667,  49802,  49941,  50085,  50232,  50384,
+   50541,  50702,  50867,  51038,  51213,  51394,  51580,  51772,
+   51969,  52172,  52381,  52596,  52817,  53045,  53264,  53384,
+   53509,  53637,  53768,  53904,  54043,  54187,  54335,  54487,
+   54643,  54804,  54970,  55141,  55317,  55498,  55684,  55876,
+   56073,  56277,  56486,  56701,  56923,  57151,  57365,  57486,
+   57610,  57738,  57870,  58006,  58145,  58289,  58437,  58589,
+   58746,  58907,  59074,  59245,  59421,  59602,  59788,  59980,
+   60178,  60381,  60591,  60806,  61028,  61257,  61466,  61587,
+   61711,  61840,  61972,  62107,  62247,  62391,  62539,  62692,
+};
+
+
+const prog_uint16_t* lookup_table_exp_table[] = {
   lut_res_lfo_increments,
-  lut_res_env_increments,
 };
 
 const prog_uint8_t wav_res_deadband[] PROGMEM = {
@@ -792,6 +797,40 @@ const prog_uint8_t wav_res_drum_map_node_24[] PROGMEM = {
       95,      0,      0,      0,      0,     63,      0,      0,
      127,      0,      0,      0,      0,     31,      0,      0,
 };
+const prog_uint8_t wav_res_hh_opl2[] PROGMEM = {
+       0,       1,       0,       1,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       0,       1,       0,       1,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       0,       1,       0,       1,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       0,       1,       0,       1,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       0,       1,       0,       1,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       0,       1,       0,       1,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       0,       1,       0,       1,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       2,       3,       2,       3,
+       2,       3,       2,       3,       0,       1,       0,       1,
+       2,       3,       2,       3,       2,       3,       2,       3,
+};
 
 
 const prog_uint8_t* waveform_table[] = {
@@ -824,6 +863,7 @@ const prog_uint8_t* waveform_table[] = {
   wav_res_drum_map_node_22,
   wav_res_drum_map_node_23,
   wav_res_drum_map_node_24,
+  wav_res_hh_opl2,
 };
 
 
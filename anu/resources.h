@@ -42,13 +42,14 @@ extern const prog_uint16_t* lookup_table_table[];
 
 extern const prog_uint32_t* lookup_table_32_table[];
 
+extern const prog_uint16_t* lookup_table_exp_table[];
+
 extern const prog_uint8_t* waveform_table[];
 
 extern const prog_uint16_t lut_res_glide_increments[] PROGMEM;
 extern const prog_uint16_t lut_res_drm_env_increments[] PROGMEM;
 extern const prog_uint16_t lut_res_drm_phase_increments[] PROGMEM;
 extern const prog_uint16_t lut_res_dco_pitch[] PROGMEM;
-extern const prog_uint16_t lut_res_env_expo[] PROGMEM;
 extern const prog_uint16_t lut_res_groove_swing[] PROGMEM;
 extern const prog_uint16_t lut_res_groove_shuffle[] PROGMEM;
 extern const prog_uint16_t lut_res_groove_push[] PROGMEM;
@@ -56,8 +57,9 @@ extern const prog_uint16_t lut_res_groove_lag[] PROGMEM;
 extern const prog_uint16_t lut_res_groove_human[] PROGMEM;
 extern const prog_uint16_t lut_res_groove_monkey[] PROGMEM;
 extern const prog_uint16_t lut_res_arpeggiator_patterns[] PROGMEM;
-extern const prog_uint32_t lut_res_lfo_increments[] PROGMEM;
-extern const prog_uint32_t lut_res_env_increments[] PROGMEM;
+extern const prog_uint16_t lut_res_log2[] PROGMEM;
+extern const prog_uint32_t lut_res_env_coefficients[] PROGMEM;
+extern const prog_uint16_t lut_res_lfo_increments[] PROGMEM;
 extern const prog_uint8_t wav_res_deadband[] PROGMEM;
 extern const prog_uint8_t wav_res_pitch_deadband[] PROGMEM;
 extern const prog_uint8_t wav_res_drm_envelope[] PROGMEM;
@@ -87,6 +89,7 @@ extern const prog_uint8_t wav_res_drum_map_node_21[] PROGMEM;
 extern const prog_uint8_t wav_res_drum_map_node_22[] PROGMEM;
 extern const prog_uint8_t wav_res_drum_map_node_23[] PROGMEM;
 extern const prog_uint8_t wav_res_drum_map_node_24[] PROGMEM;
+extern const prog_uint8_t wav_res_hh_opl2[] PROGMEM;
 #define STR_RES_DUMMY 0  // dummy
 #define LUT_RES_GLIDE_INCREMENTS 0
 #define LUT_RES_GLIDE_INCREMENTS_SIZE 256
@@ -96,26 +99,26 @@ extern const prog_uint8_t wav_res_drum_map_node_24[] PROGMEM;
 #define LUT_RES_DRM_PHASE_INCREMENTS_SIZE 257
 #define LUT_RES_DCO_PITCH 3
 #define LUT_RES_DCO_PITCH_SIZE 97
-#define LUT_RES_ENV_EXPO 4
-#define LUT_RES_ENV_EXPO_SIZE 257
-#define LUT_RES_GROOVE_SWING 5
+#define LUT_RES_GROOVE_SWING 4
 #define LUT_RES_GROOVE_SWING_SIZE 16
-#define LUT_RES_GROOVE_SHUFFLE 6
+#define LUT_RES_GROOVE_SHUFFLE 5
 #define LUT_RES_GROOVE_SHUFFLE_SIZE 16
-#define LUT_RES_GROOVE_PUSH 7
+#define LUT_RES_GROOVE_PUSH 6
 #define LUT_RES_GROOVE_PUSH_SIZE 16
-#define LUT_RES_GROOVE_LAG 8
+#define LUT_RES_GROOVE_LAG 7
 #define LUT_RES_GROOVE_LAG_SIZE 16
-#define LUT_RES_GROOVE_HUMAN 9
+#define LUT_RES_GROOVE_HUMAN 8
 #define LUT_RES_GROOVE_HUMAN_SIZE 16
-#define LUT_RES_GROOVE_MONKEY 10
+#define LUT_RES_GROOVE_MONKEY 9
 #define LUT_RES_GROOVE_MONKEY_SIZE 16
-#define LUT_RES_ARPEGGIATOR_PATTERNS 11
+#define LUT_RES_ARPEGGIATOR_PATTERNS 10
 #define LUT_RES_ARPEGGIATOR_PATTERNS_SIZE 6
+#define LUT_RES_LOG2 11
+#define LUT_RES_LOG2_SIZE 257
+#define LUT_RES_ENV_COEFFICIENTS 0
+#define LUT_RES_ENV_COEFFICIENTS_SIZE 256
 #define LUT_RES_LFO_INCREMENTS 0
 #define LUT_RES_LFO_INCREMENTS_SIZE 256
-#define LUT_RES_ENV_INCREMENTS 1
-#define LUT_RES_ENV_INCREMENTS_SIZE 256
 #define WAV_RES_DEADBAND 0
 #define WAV_RES_DEADBAND_SIZE 256
 #define WAV_RES_PITCH_DEADBAND 1
@@ -174,6 +177,8 @@ extern const prog_uint8_t wav_res_drum_map_node_24[] PROGMEM;
 #define WAV_RES_DRUM_MAP_NODE_23_SIZE 96
 #define WAV_RES_DRUM_MAP_NODE_24 28
 #define WAV_RES_DRUM_MAP_NODE_24_SIZE 96
+#define WAV_RES_HH_OPL2 29
+#define WAV_RES_HH_OPL2_SIZE 256
 typedef avrlib::ResourcesManager<
     ResourceId,
     avrlib::ResourcesTables<
@@ -0,0 +1,108 @@
+#!/usr/bin/python2.5
+#
+# Copyright 2012 Olivier Gillet.
+#
+# Author: Olivier Gillet (ol.gillet@gmail.com)
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# -----------------------------------------------------------------------------
+#
+# Hi-hat samples, 8-bit signed, recorded at the audio rate. They are truncated
+# to 4096 samples, the last 256 of which are faded out.
+#
+# They are not part of the resource tables: they are written to their own
+# source file, in which each sample is compiled only when NUM_HH_SAMPLES
+# selects it. To be run from the root of the repository:
+#
+# make -f anu/makefile hh_samples
+
+import os
+
+SAMPLE_NAMES = ['909', 'linn', 'dt']
+SAMPLE_SIZE = 4096
+FADE_SIZE = 256
+
+RESOURCES_DIR = os.path.dirname(os.path.abspath(__file__))
+OUTPUT_FILE = os.path.join(RESOURCES_DIR, '..', 'hh_samples.cc')
+
+HEADER = """// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Hi-hat samples.
+//
+// Automatically generated with:
+// make -f anu/makefile hh_samples
+
+#include "anu/hh_samples.h"
+
+namespace anu {
+"""
+
+FOOTER = """
+}  // namespace anu
+"""
+
+
+def LoadSample(name):
+  data = open(os.path.join(RESOURCES_DIR, 'hh_%s.raw' % name), 'rb').read()
+  sample = [ord(x) if isinstance(x, str) else x for x in data[:SAMPLE_SIZE]]
+  sample = [x - 256 if x >= 128 else x for x in sample]
+  for i in range(FADE_SIZE):
+    # Rounded towards 0.
+    gain = 1.0 - i / float(FADE_SIZE - 1)
+    index = SAMPLE_SIZE - FADE_SIZE + i
+    sample[index] = int(sample[index] * gain)
+  return [x % 256 for x in sample]
+
+
+def main():
+  lines = [HEADER]
+  for index, name in enumerate(SAMPLE_NAMES):
+    sample = LoadSample(name)
+    lines.append('#if NUM_HH_SAMPLES > %d' % index)
+    lines.append('static const prog_uint8_t hh_sample_%s[] PROGMEM = {' % name)
+    for i in range(0, len(sample), 8):
+      lines.append('  ' + ' '.join('%6d,' % x for x in sample[i:i + 8]))
+    lines.append('};')
+    lines.append('#endif  // NUM_HH_SAMPLES > %d' % index)
+    lines.append('')
+  lines.append('#if NUM_HH_SAMPLES > 0')
+  lines.append('const prog_uint8_t* hh_sample_table[] = {')
+  for index, name in enumerate(SAMPLE_NAMES):
+    if index:
+      lines.append('#if NUM_HH_SAMPLES > %d' % index)
+    lines.append('  hh_sample_%s,' % name)
+    if index:
+      lines.append('#endif  // NUM_HH_SAMPLES > %d' % index)
+  lines.append('};')
+  lines.append('#endif  // NUM_HH_SAMPLES > 0')
+  lines.append(FOOTER)
+  open(OUTPUT_FILE, 'w').write('\n'.join(lines))
+
+
+if __name__ == '__main__':
+  main()
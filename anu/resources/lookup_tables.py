@@ -27,6 +27,27 @@ LFO and envelope increments.
 
 lookup_tables = []
 lookup_tables_32 = []
+lookup_tables_exp = []
+
+
+def ExponentEncode(values):
+  # Stores 32-bit values on 16 bits, as a 4-bit exponent and a 12-bit mantissa
+  # with an implicit leading 1: value = (4096 + mantissa) << exponent. This
+  # covers 4096 to 2^28 with a relative error below 1 / 8192, and is suitable
+  # for tables spanning a wide range of magnitudes, like exponential
+  # increments. Decoded by DecodeExponent in dsp_utils.h.
+  encoded = []
+  for value in values:
+    value = max(int(value), 4096)
+    exponent = max(0, len(bin(value)) - 2 - 13)
+    mantissa = (value + (1 << exponent >> 1)) >> exponent
+    if mantissa >= 8192:
+      exponent += 1
+      mantissa = (value + (1 << exponent >> 1)) >> exponent
+    assert exponent < 16
+    encoded.append((exponent << 12) | (mantissa - 4096))
+  return numpy.array(encoded)
+
 
 control_rate = 20000000 / 510 / 8.0 / 2
 min_frequency = 1.0 / 16.0  # Hertz
@@ -40,8 +61,8 @@ rates = numpy.linspace(numpy.log(min_increment),
                        numpy.log(max_increment), num_values)
 lfo_increments = numpy.exp(rates).astype(int)
 lfo_increments[0:2] = 0
-lookup_tables_32.append(
-    ('lfo_increments', lfo_increments)
+lookup_tables_exp.append(
+    ('lfo_increments', ExponentEncode(lfo_increments))
 )
 
 
@@ -56,8 +77,14 @@ rates = numpy.linspace(numpy.power(max_increment, -gamma),
                        numpy.power(min_increment, -gamma), num_values)
 
 values = numpy.power(rates, -1 / gamma).astype(int)
+
+# The envelope segments are computed by recurrence: the distance to an
+# asymptote placed slightly beyond the target is multiplied at each sample by
+# (1 - coefficient), so that it shrinks by a factor of exp(-4) over the
+# duration of the segment.
+coefficients = 1.0 - numpy.exp(-4.0 * values / (65536 * 65536.0))
 lookup_tables_32.append(
-    ('env_increments', values)
+    ('env_coefficients', numpy.round(coefficients * 65536 * 65536.0))
 )
 
 
@@ -113,19 +140,6 @@ lookup_tables.append(
     ('dco_pitch', numpy.round(values))
 )
 
-"""----------------------------------------------------------------------------
-Envelope curves
------------------------------------------------------------------------------"""
-
-env_linear = numpy.arange(0, 257.0) / 256.0
-env_linear[-1] = env_linear[-2]
-env_quartic = 1.0 - (1.0 - env_linear) ** 2.0
-env_expo = 1.0 - numpy.exp(-4 * env_linear)
-
-# lookup_tables.append(('env_linear', env_linear / env_linear.max() * 65535.0))
-# lookup_tables.append(('env_quartic', env_quartic / env_quartic.max() * 65535.0))
-lookup_tables.append(('env_expo', env_expo / env_expo.max() * 65535.0))
-
 """----------------------------------------------------------------------------
 Groove templates
 ----------------------------------------------------------------------------"""
@@ -187,4 +201,16 @@ lookup_tables.append(
       'ooo- ooo- ooo- ooo-',
       'o--o --o- -o-- o-o-',
       'oo-o -oo- oo-o -oo-',
-      'oooo -oo- oooo -oo-'])))
\ No newline at end of file
+      'oooo -oo- oooo -oo-'])))
+
+
+
+"""----------------------------------------------------------------------------
+Base 2 logarithm of the mantissa, for the VCO calibration.
+----------------------------------------------------------------------------"""
+
+values = numpy.round(numpy.log2(1.0 + numpy.arange(257.0) / 256.0) * 65536)
+values[-1] = 65535
+lookup_tables.append(
+    ('log2', values)
+)
@@ -63,6 +63,8 @@ resources = [
    'lookup_table', 'LUT_RES', 'prog_uint16_t', int, True),
   (lookup_tables.lookup_tables_32,
    'lookup_table_32', 'LUT_RES', 'prog_uint32_t', int, True),
+  (lookup_tables.lookup_tables_exp,
+   'lookup_table_exp', 'LUT_RES', 'prog_uint16_t', int, True),
   (waveforms.waveforms,
    'waveform', 'WAV_RES', 'prog_uint8_t', int, True),
 ]
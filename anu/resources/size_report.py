@@ -0,0 +1,84 @@
+#!/usr/bin/python2.5
+#
+# Copyright 2012 Olivier Gillet.
+#
+# Author: Olivier Gillet (ol.gillet@gmail.com)
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# -----------------------------------------------------------------------------
+#
+# Flash footprint of each resource table, as generated from resources.py.
+# To be run from the root of the repository:
+#
+# make -f anu/makefile resources_report
+
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+import resources
+
+TYPE_WIDTHS = {
+  'prog_char': 1,
+  'prog_uint8_t': 1,
+  'prog_uint16_t': 2,
+  'prog_uint32_t': 4,
+}
+
+# Tables stored in a compressed encoding, with the width of the values they
+# represent.
+DECODED_WIDTHS = {
+  'lookup_table_exp': 4,
+}
+
+
+def TableSizes():
+  for data, category, prefix, c_type, python_type, _ in resources.resources:
+    width = TYPE_WIDTHS[c_type]
+    decoded_width = DECODED_WIDTHS.get(category, width)
+    if python_type == str:
+      for string in data.split('\n'):
+        yield category, string, len(string) + 1, width, decoded_width
+    else:
+      for name, values in data:
+        yield category, name, len(values), width, decoded_width
+
+
+def main():
+  total = 0
+  saved = 0
+  category_totals = {}
+  categories = []
+  sys.stdout.write('%-20s %-32s %8s %8s %8s\n' % (
+      'category', 'table', 'entries', 'bytes', 'saved'))
+  for category, name, entries, width, decoded_width in TableSizes():
+    size = entries * width
+    table_saved = entries * (decoded_width - width)
+    sys.stdout.write('%-20s %-32s %8d %8d %8d\n' % (
+        category, name, entries, size, table_saved))
+    if category not in category_totals:
+      categories.append(category)
+      category_totals[category] = 0
+    category_totals[category] += size
+    total += size
+    saved += table_saved
+  sys.stdout.write('\n')
+  for category in categories:
+    sys.stdout.write('%-20s %52d\n' % (category, category_totals[category]))
+  sys.stdout.write('%-20s %52d\n' % ('total', total))
+  sys.stdout.write('%-20s %52d\n' % ('saved by encodings', saved))
+
+
+if __name__ == '__main__':
+  main()
@@ -55,11 +55,6 @@ waveforms.append(('drm_envelope', scale(expo_decay, min=0, max=255)))
 sine = -numpy.sin(numpy.arange(257) / float(257) * 2 * numpy.pi) * 127.5 + 127.5
 waveforms.append(('sine', scale(sine) + 128))
 
-# HH
-#hh = map(ord, file('anu/resources/hh_linn.raw').read())
-#hh = hh[:4097]
-#waveforms.append(('hh', hh))
-
 # DrumMap nodes (BER:NOTE: migrated from GRIDS)
 nodes = [
 [
@@ -266,3 +261,20 @@ nodes = [
 
 for i, p in enumerate(nodes):
   waveforms.append(('drum_map_node_%d' % i, p))
+
+# OPL2/YM3812 style hi-hat phase bits logic. The index is built from the two
+# hi-hat operators phases and a noise bit:
+#   bits 7, 3, 2: bits 7, 3, 2 of the 1st operator phase MSB.
+#   bits 6, 4: bits 5, 3 of the 2nd operator phase MSB.
+#   bit 0: noise.
+# The output selects one of the 4 precomputed hi-hat sample values:
+#   bit 1: negative half-wave, bit 0: noise applied.
+hh_opl2 = []
+for i in xrange(256):
+  bit = lambda n: (i >> n) & 1
+  res1 = bit(3) | (bit(2) ^ bit(7))
+  res2 = bit(4) ^ bit(6)
+  hh_opl2.append(((res1 | res2) << 1) | bit(0))
+waveforms.append(('hh_opl2', hh_opl2))
+
+# The hi-hat samples are generated by hh_samples.py.
@@ -0,0 +1,180 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "anu/storage.h"
+
+#include <avr/eeprom.h>
+#include <avr/interrupt.h>
+#include <avr/io.h>
+
+namespace anu {
+
+/* static */
+StorageRequest Storage::requests_[kStorageQueueSize];
+
+/* static */
+volatile uint8_t Storage::num_requests_;
+
+/* static */
+uint16_t Storage::offset_;
+
+/* static */
+uint8_t Storage::checksum_;
+
+/* static */
+void Storage::Queue(
+    const uint8_t* data,
+    StorageByteSource read_byte,
+    uint8_t* address,
+    uint16_t size) {
+  uint8_t sreg = SREG;
+  cli();
+  uint8_t i = 0;
+  while (i < num_requests_ && requests_[i].address != address) {
+    ++i;
+  }
+  if (i == kStorageQueueSize) {
+    // Only if more objects than requests are saved.
+    SREG = sreg;
+    Flush();
+    cli();
+    i = 0;
+  }
+  if (i == 0) {
+    // The object was being written, restart from its first byte to make sure
+    // its most recent state is saved.
+    offset_ = 0;
+    checksum_ = 0;
+  }
+  requests_[i].data = data;
+  requests_[i].read_byte = read_byte;
+  requests_[i].address = address;
+  requests_[i].size = size;
+  if (i == num_requests_) {
+    ++num_requests_;
+  }
+  EECR |= _BV(EERIE);
+  SREG = sreg;
+}
+
+/* static */
+bool Storage::pending(const uint8_t* address) {
+  uint8_t sreg = SREG;
+  cli();
+  bool found = false;
+  for (uint8_t i = 0; i < num_requests_; ++i) {
+    if (requests_[i].address == address) {
+      found = true;
+    }
+  }
+  SREG = sreg;
+  return found;
+}
+
+/* static */
+bool Storage::Cancel(const uint8_t* address) {
+  uint8_t sreg = SREG;
+  cli();
+  uint8_t i = 0;
+  while (i < num_requests_ && requests_[i].address != address) {
+    ++i;
+  }
+  bool found = i < num_requests_;
+  if (found) {
+    if (i == 0) {
+      offset_ = 0;
+      checksum_ = 0;
+    }
+    --num_requests_;
+    for (; i < num_requests_; ++i) {
+      requests_[i] = requests_[i + 1];
+    }
+  }
+  SREG = sreg;
+  return found;
+}
+
+/* static */
+void Storage::Load(
+    void* data,
+    uint8_t* address,
+    uint16_t size,
+    const prog_char* default_data,
+    bool force_reinitialization) {
+  if (!Read(data, address, size) || force_reinitialization) {
+    memcpy_P(data, default_data, size);
+  }
+}
+
+/* static */
+bool Storage::Read(void* data, uint8_t* address, uint16_t size) {
+  Flush();
+  eeprom_read_block(data, address, size);
+  uint16_t checksum = eeprom_read_byte(address + size);
+  return checksum == Checksum(data, size);
+}
+
+/* static */
+void Storage::Flush() {
+  while (num_requests_) {
+    uint8_t sreg = SREG;
+    cli();
+    if (!(EECR & _BV(EEPE))) {
+      WriteNextByte();
+    }
+    SREG = sreg;
+  }
+}
+
+/* static */
+void Storage::WriteNextByte() {
+  for (uint8_t n = kStorageMaxComparisonsPerInterrupt; n; --n) {
+    if (!num_requests_) {
+      EECR &= ~_BV(EERIE);
+      return;
+    }
+    const StorageRequest& request = requests_[0];
+    uint8_t* address = request.address + offset_;
+    uint8_t value;
+    if (offset_ < request.size) {
+      value = request.read_byte
+          ? request.read_byte(offset_)
+          : request.data[offset_];
+      checksum_ += value;
+      ++offset_;
+    } else {
+      // Commit.
+      value = checksum_;
+      offset_ = 0;
+      checksum_ = 0;
+      --num_requests_;
+      for (uint8_t i = 0; i < num_requests_; ++i) {
+        requests_[i] = requests_[i + 1];
+      }
+    }
+    if (eeprom_read_byte(address) != value) {
+      // The EEPROM is ready, so this returns immediately, and the interrupt
+      // fires again when the byte has been written.
+      eeprom_write_byte(address, value);
+      return;
+    }
+  }
+}
+
+/* extern */
+Storage storage;
+
+}  // namespace anu
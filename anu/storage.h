@@ -19,7 +19,6 @@
 #include "avrlib/base.h"
 
 #include <avr/pgmspace.h>
-#include <avr/eeprom.h>
 
 namespace anu {
 
@@ -30,6 +29,38 @@ struct StorageLayout {
   static const prog_char* init_data() { while(1); }
 };
 
+// Saves are asynchronous: Save() queues a request and returns, and the bytes
+// are written one at a time from the EEPROM ready interrupt. Bytes which are
+// already equal to their EEPROM copy are not written. The checksum byte which
+// follows each object is written last, so an object whose writing has been
+// interrupted by a power loss fails its checksum and is reinitialized when
+// loaded. The object is read when its bytes are written, not when Save() is
+// called, so it must stay allocated - it is expected to be a static member
+// or a global.
+//
+// A save of an object already in the queue replaces its request, and the
+// queue has one request for each object saved - the system settings, the
+// patch, the sequencer settings and the 4 sequence slots - so saves never
+// wait for the queue to drain.
+static const uint8_t kStorageQueueSize = 7;
+
+// Number of identical bytes that can be compared in a single interrupt before
+// yielding.
+static const uint8_t kStorageMaxComparisonsPerInterrupt = 8;
+
+// When read_byte is set, the bytes to write are generated by this function,
+// called with increasing offsets starting from 0, instead of being copied from
+// data. This allows an object to be saved in a more compact encoding without
+// a RAM buffer for the encoded copy.
+typedef uint8_t (*StorageByteSource)(uint16_t offset);
+
+struct StorageRequest {
+  const uint8_t* data;
+  StorageByteSource read_byte;
+  uint8_t* address;
+  uint16_t size;
+};
+
 class Storage {
  public:
   template<typename T>
@@ -59,25 +90,50 @@ class Storage {
   };
 
   static void Save(const void* data, uint8_t* address, uint16_t size) {
-    uint8_t checksum = Checksum(data, size);
-    eeprom_write_block(data, address, size);
-    eeprom_write_byte(address + size, checksum);
-  };
+    Queue(static_cast<const uint8_t*>(data), NULL, address, size);
+  }
+  
+  static void Save(
+      StorageByteSource read_byte,
+      uint8_t* address,
+      uint16_t size) {
+    Queue(NULL, read_byte, address, size);
+  }
 
   static void Load(
       void* data,
       uint8_t* address,
       uint16_t size,
       const prog_char* default_data,
-      bool force_reinitialization) {
-    eeprom_read_block(data, address, size);
-    uint16_t checksum = eeprom_read_byte(address + size);
-    if (checksum != Checksum(data, size) || force_reinitialization) {
-      memcpy_P(data, default_data, size);
-    }
-  };
+      bool force_reinitialization);
+  
+  // Reads an object without reinitializing it, and returns whether its
+  // checksum is valid.
+  static bool Read(void* data, uint8_t* address, uint16_t size);
+  
+  // Blocks until all the queued requests have been written.
+  static void Flush();
+  
+  // Called from the EEPROM ready interrupt.
+  static void WriteNextByte();
+  
+  static inline bool busy() { return num_requests_ != 0; }
+  
+  // Whether a save to the given address is queued or in progress.
+  static bool pending(const uint8_t* address);
+  
+  // Removes the save to the given address from the queue, and returns whether
+  // there was one. A save in progress is left without its checksum, so the
+  // object must be saved again.
+  static bool Cancel(const uint8_t* address);
   
  private:
+  static void Queue(
+      const uint8_t* data,
+      StorageByteSource read_byte,
+      uint8_t* address,
+      uint16_t size);
+
   static uint8_t Checksum(const void* data, uint16_t size) {
     uint8_t s = 0;
     const uint8_t* d = static_cast<const uint8_t*>(data);
@@ -86,6 +142,13 @@ class Storage {
     }
     return s;
   }
+  
+  static StorageRequest requests_[kStorageQueueSize];
+  static volatile uint8_t num_requests_;
+  
+  // Progress on the first request of the queue.
+  static uint16_t offset_;
+  static uint8_t checksum_;
 };
 
 extern Storage storage;
@@ -19,6 +19,8 @@
 
 #include "anu/strummer.h"
 
+#include "avrlib/time.h"
+
 #include "anu/voice_controller.h"
 
 namespace anu {
@@ -26,12 +28,19 @@ namespace anu {
 /* static */
 uint8_t Strummer::current_note_;
 
+/* static */
+uint8_t Strummer::target_note_;
+
+/* static */
+uint32_t Strummer::last_note_time_;
+
 /* static */
 StrummerData Strummer::data_ = { 0, 2, 5, 7, 4 };
 
 /* static */
 void Strummer::Start() {
   current_note_ = 0xff;
+  target_note_ = ComputeNote();
   PlayNote();
 }
 
@@ -63,11 +72,19 @@ void Strummer::Update(uint8_t pot, uint8_t value) {
   value = U8U8MulShift8(pgm_read_byte(ranges + pot), value);
   uint8_t* address = static_cast<uint8_t*>(static_cast<void*>(&data_));
   address[pot] = value;
-  PlayNote();
+  target_note_ = ComputeNote();
 };
 
 /* static */
-void Strummer::PlayNote() {
+void Strummer::Tick() {
+  if (target_note_ != current_note_ &&
+      milliseconds() - last_note_time_ >= kStrummerMinInterval) {
+    PlayNote();
+  }
+}
+
+/* static */
+uint8_t Strummer::ComputeNote() {
   int16_t note = data_.root_note + 48;
   note += static_cast<int8_t>(
       pgm_read_byte(octave_shift + data_.octave_shift));
@@ -83,12 +100,19 @@ void Strummer::PlayNote() {
   while (note > 96) {
     note -= 12;
   }
+  return note;
+}
+
+/* static */
+void Strummer::PlayNote() {
+  uint8_t note = target_note_;
   if (note != current_note_) {
     voice_controller.NoteOn(note, 100);
     if (current_note_ != 0xff) {
       voice_controller.NoteOff(current_note_);
     }
     current_note_ = note;
+    last_note_time_ = milliseconds();
   }
 }
 
@@ -24,8 +24,17 @@
 
 #include "anu/midi_dispatcher.h"
 
+#ifndef STRUMMER_MIN_INTERVAL
+#define STRUMMER_MIN_INTERVAL 16
+#endif  // STRUMMER_MIN_INTERVAL
+
 namespace anu {
 
+// Minimum time between two notes, in ms. The pots update the target note as
+// fast as they move, but a fast sweep only plays the notes it is on when this
+// interval elapses - and always ends on the last one.
+static const uint8_t kStrummerMinInterval = STRUMMER_MIN_INTERVAL;
+
 struct StrummerData {
   uint8_t root_note;
   uint8_t octave_shift;
@@ -40,10 +49,15 @@ class Strummer {
   
   static void Start();
   static void Update(uint8_t pot, uint8_t value);
+  static void Tick();
   static void PlayNote();
 
  private:
+  static uint8_t ComputeNote();
+  
   static uint8_t current_note_;
+  static uint8_t target_note_;
+  static uint32_t last_note_time_;
   static StrummerData data_;
   
   DISALLOW_COPY_AND_ASSIGN(Strummer);
@@ -15,7 +15,13 @@
 
 #include "anu/sysex_handler.h"
 
+#include <string.h>
+
+#include "anu/diagnostics.h"
+#include "anu/latency_meter.h"
 #include "anu/midi_dispatcher.h"
+#include "anu/parameter.h"
+#include "anu/profiler.h"
 #include "anu/storage.h"
 #include "anu/system_settings.h"
 #include "anu/voice_controller.h"
@@ -23,13 +29,13 @@
 namespace anu {
 
 /* static */
-uint8_t SysExHandler::rx_buffer_[129];
+uint8_t SysExHandler::rx_staging_buffer_[kSysExStagingBufferSize];
 
 /* static */
-uint8_t* SysExHandler::rx_destination_;
+uint16_t SysExHandler::rx_bytes_received_;
 
 /* static */
-uint16_t SysExHandler::rx_bytes_received_;
+uint16_t SysExHandler::rx_data_index_;
 
 /* static */
 uint16_t SysExHandler::rx_expected_size_;
@@ -40,9 +46,51 @@ SysExReceptionState SysExHandler::rx_state_;
 /* static */
 uint8_t SysExHandler::rx_checksum_;
 
+/* static */
+uint8_t SysExHandler::rx_received_checksum_;
+
+/* static */
+uint8_t SysExHandler::rx_high_bits_;
+
+/* static */
+uint8_t SysExHandler::rx_group_mask_;
+
 /* static */
 uint8_t SysExHandler::rx_command_[2];
 
+/* static */
+uint8_t SysExHandler::dump_command_;
+
+/* static */
+uint8_t SysExHandler::dump_argument_;
+
+/* static */
+const uint8_t* SysExHandler::dump_data_ = NULL;
+
+/* static */
+uint8_t SysExHandler::dump_size_;
+
+/* static */
+uint16_t SysExHandler::dump_position_;
+
+/* static */
+uint8_t SysExHandler::dump_checksum_;
+
+/* static */
+uint8_t SysExHandler::dump_group_[7];
+
+/* static */
+uint8_t SysExHandler::dump_object_ = SYSEX_OBJECT_TYPE_LAST;
+
+/* static */
+bool SysExHandler::dump_packed_;
+
+/* static */
+uint8_t SysExHandler::pending_report_ = SYSEX_DIAGNOSTIC_TYPE_LAST;
+
+/* static */
+SysExReport SysExHandler::report_;
+
 static const prog_uint8_t header[] PROGMEM = {
   0xf0,  // <SysEx>
   0x00, 0x21, 0x02,  // Mutable Instruments manufacturer ID.
@@ -50,12 +98,31 @@ static const prog_uint8_t header[] PROGMEM = {
   // Then:
   // * Command byte:
   // - 0x01: Data structure dump
-  // * Argument byte:
+  // - 0x02: Diagnostic report
+  // - 0x11: Data structure dump request
+  // - 0x12: Diagnostic report request
+  // - 0x21: Data structure dump, packed
+  // - 0x31: Data structure dump request, packed
+  // * Argument byte for data structures:
   // - 0x00: System Settings
   // - 0x01: Patch
   // - 0x02: SequencerSettings
   // - 0x03: Sequence (first block of 128 bytes)
   // - 0x04: Sequence (second block of remaining bytes)
+  // * Argument byte for diagnostic reports:
+  // - 0x00: Profiler statistics (only with ENABLE_PROFILER)
+  // - 0x01: Glitch counters (buffer underruns, MIDI input errors and drops)
+  //   and buffer fill levels
+  // - 0x02: Static RAM size, stack high-water mark and never used RAM
+  // - 0x03: Note on to gate and clock to trig latency histograms (only with
+  //   ENABLE_LATENCY_METER)
+  // * Data, followed by a checksum byte (sum of the data bytes, mod 256):
+  // - Unpacked: each byte is sent as two nibbles, high nibble first.
+  // - Packed: the bytes are sent by groups of 7. Each group is preceded by a
+  //   byte holding their MSBs, the MSB of the first byte of the group in
+  //   bit 0. The checksum is packed with the data, and the last group may be
+  //   shorter than 7 bytes.
+  // * 0xf7 <End of SysEx>
 };
 
 static const prog_uint8_t block_sizes[] PROGMEM = {
@@ -95,69 +162,227 @@ uint8_t SysExHandler::GetObjectSize(SysExObjectType type) {
 
 /* static */
 void SysExHandler::ParseCommand() {
+  STATIC_ASSERT(sizeof(SystemSettingsData) <= kSysExStagingBufferSize);
+  STATIC_ASSERT(sizeof(Patch) <= kSysExStagingBufferSize);
+  STATIC_ASSERT(sizeof(SequencerSettings) <= kSysExStagingBufferSize);
+  STATIC_ASSERT(sizeof(Sequence) - 128 <= kSysExStagingBufferSize);
   rx_bytes_received_ = 0;
+  rx_data_index_ = 0;
+  rx_group_mask_ = 1;
   rx_state_ = RECEIVING_DATA;
-  rx_destination_ = rx_buffer_;
   switch (rx_command_[0]) {
+    case 0x21:  // Data structure transfer, packed
+      rx_group_mask_ = 7;
     case 0x01:  // Data structure transfer
-      {
+      if (rx_command_[1] < SYSEX_OBJECT_TYPE_LAST) {
         SysExObjectType type = static_cast<SysExObjectType>(rx_command_[1]);
         rx_expected_size_ = GetObjectSize(type);
+      } else {
+        rx_state_ = RECEPTION_ERROR;
       }
       break;
     
     case 0x11:  // Data structure dump request
+    case 0x12:  // Diagnostic report request
+    case 0x31:  // Data structure dump request, packed
       rx_expected_size_ = 0;
       break;
 
     default:
-      rx_state_ = RECEIVING_FOOTER;
+      rx_state_ = RECEPTION_ERROR;
       break;
   }
 }
 
 /* static */
-void SysExHandler::BulkDump() {
-  for (uint8_t object = 0; object < SYSEX_OBJECT_TYPE_LAST; ++object) {
-    SysExObjectType type = static_cast<SysExObjectType>(object);
-    const uint8_t* data = static_cast<uint8_t*>(GetObjectAddress(type));
-    uint8_t size = GetObjectSize(type);
-    
-    // Header.
-    for (uint8_t i = 0; i < sizeof(header); ++i) {
-      midi_dispatcher.SendBlocking(pgm_read_byte(header + i));
+void SysExHandler::BulkDump(bool packed) {
+  // A message in progress is completed first.
+  dump_object_ = 0;
+  dump_packed_ = packed;
+  if (!dumping()) {
+    StartDumpMessage();
+  }
+}
+
+/* static */
+bool SysExHandler::busy() {
+  return dumping() || midi_dispatcher.holding();
+}
+
+/* static */
+void SysExHandler::Refresh() {
+  while (midi_dispatcher.writable_low_priority()) {
+    if (dump_position_ == 0) {
+      // Between two messages of the dump, or once it is complete.
+      if (!midi_dispatcher.ReleaseHeldMessages() || !dumping()) {
+        break;
+      }
     }
-    
-    // Command and argument.
-    midi_dispatcher.SendBlocking(0x01);
-    midi_dispatcher.SendBlocking(object);
-    
-    // Outputs the data.
-    uint8_t checksum = 0;
-    for (uint8_t i = 0; i < size; ++i) {
-      checksum += data[i];
-      midi_dispatcher.SendBlocking(U8ShiftRight4(data[i]));
-      midi_dispatcher.SendBlocking(data[i] & 0x0f);
+    midi_dispatcher.SendBlocking(NextDumpByte());
+  }
+}
+
+/* static */
+void SysExHandler::FinishMessage() {
+  while (dumping() && dump_position_) {
+    midi_dispatcher.SendBlocking(NextDumpByte());
+  }
+}
+
+/* static */
+void SysExHandler::StartDumpMessage() {
+  // The next object of the bulk dump in progress, if any, then the pending
+  // diagnostic report.
+  dump_position_ = 0;
+  dump_data_ = NULL;
+  if (dump_object_ < SYSEX_OBJECT_TYPE_LAST) {
+    SysExObjectType type = static_cast<SysExObjectType>(dump_object_);
+    dump_command_ = dump_packed_ ? 0x21 : 0x01;
+    dump_argument_ = dump_object_;
+    dump_data_ = static_cast<const uint8_t*>(GetObjectAddress(type));
+    dump_size_ = GetObjectSize(type);
+    ++dump_object_;
+    return;
+  }
+  
+  uint8_t type = pending_report_;
+  pending_report_ = SYSEX_DIAGNOSTIC_TYPE_LAST;
+  dump_command_ = 0x02;
+  dump_argument_ = type;
+  switch (type) {
+#ifdef ENABLE_PROFILER
+    case SYSEX_DIAGNOSTIC_TYPE_PROFILER:
+      profiler.Report(&report_.profiler);
+      dump_data_ = (const uint8_t*)(&report_.profiler);
+      dump_size_ = sizeof(ProfilerReport);
+      break;
+#endif  // ENABLE_PROFILER
+
+    case SYSEX_DIAGNOSTIC_TYPE_BUFFERS:
+      diagnostics.Report(&report_.diagnostics);
+      dump_data_ = (const uint8_t*)(&report_.diagnostics);
+      dump_size_ = sizeof(DiagnosticReport);
+      break;
+      
+    case SYSEX_DIAGNOSTIC_TYPE_MEMORY:
+      diagnostics.ReportMemory(&report_.memory);
+      dump_data_ = (const uint8_t*)(&report_.memory);
+      dump_size_ = sizeof(MemoryReport);
+      break;
+
+#ifdef ENABLE_LATENCY_METER
+    case SYSEX_DIAGNOSTIC_TYPE_LATENCY:
+      // Reset once the report has been sent.
+      dump_data_ = latency_meter.Freeze();
+      dump_size_ = sizeof(LatencyReport);
+      break;
+#endif  // ENABLE_LATENCY_METER
+  }
+}
+
+/* static */
+uint8_t SysExHandler::LoadDumpGroup(uint8_t start) {
+  // Copies the next 7 bytes of the object, followed by the checksum once the
+  // end of the object is reached, and returns their MSBs.
+  uint8_t msbs = 0;
+  uint8_t mask = 1;
+  for (uint8_t i = 0; i < 7; ++i) {
+    uint8_t index = start + i;
+    uint8_t value = 0;
+    if (index < dump_size_) {
+      value = dump_data_[index];
+      dump_checksum_ += value;
+    } else if (index == dump_size_) {
+      value = dump_checksum_;
     }
-    // Outputs a checksum.
-    midi_dispatcher.SendBlocking(U8ShiftRight4(checksum));
-    midi_dispatcher.SendBlocking(checksum & 0x0f);
+    dump_group_[i] = value;
+    if (value & 0x80) {
+      msbs |= mask;
+    }
+    mask <<= 1;
+  }
+  return msbs;
+}
 
-    // End of SysEx block.
-    midi_dispatcher.SendBlocking(0xf7);
+/* static */
+uint8_t SysExHandler::NextDumpByte() {
+  // Header, command, argument, nibbles of the data, nibbles of the checksum,
+  // footer. Packed messages have the data and checksum packed by groups of 7
+  // instead.
+  uint16_t position = dump_position_++;
+  if (position < sizeof(header)) {
+    dump_checksum_ = 0;
+    return pgm_read_byte(header + position);
+  }
+  position -= sizeof(header);
+  if (position == 0) {
+    return dump_command_;
+  } else if (position == 1) {
+    return dump_argument_;
+  }
+  position -= 2;
+  
+  uint8_t size = dump_size_;
+  if (dump_command_ == 0x21) {
+    uint8_t payload_size = size + 1;
+    uint16_t packed_size = payload_size + (payload_size + 6) / 7;
+    if (position < packed_size) {
+      uint8_t index = position & 7;
+      if (index == 0) {
+        // A whole group is read at once, so that the MSBs, the data and the
+        // checksum agree even if the object is edited while it is being sent.
+        return LoadDumpGroup((position >> 3) * 7);
+      } else {
+        return dump_group_[index - 1] & 0x7f;
+      }
+    }
+    position -= packed_size;
+  } else {
+    if (position < size * 2) {
+      if (position & 1) {
+        return dump_group_[0] & 0x0f;
+      } else {
+        // Read the byte once, so that both nibbles and the checksum agree even
+        // if the object is edited while it is being sent.
+        dump_group_[0] = dump_data_[position >> 1];
+        dump_checksum_ += dump_group_[0];
+        return U8ShiftRight4(dump_group_[0]);
+      }
+    }
+    position -= size * 2;
+    if (position == 0) {
+      return U8ShiftRight4(dump_checksum_);
+    } else if (position == 1) {
+      return dump_checksum_ & 0x0f;
+    }
   }
+  if (dump_command_ == 0x02 &&
+      dump_argument_ == SYSEX_DIAGNOSTIC_TYPE_LATENCY) {
+    latency_meter.Reset();
+  }
+  StartDumpMessage();
+  return 0xf7;
 }
 
 /* static */
 void SysExHandler::AcceptBuffer() {
   switch (rx_command_[0]) {
     case 0x01:  // Transfer
+    case 0x21:  // Packed transfer
       {
         SysExObjectType type = static_cast<SysExObjectType>(rx_command_[1]);
-        void* address = GetObjectAddress(type);
-        uint8_t size = GetObjectSize(type);
-        memcpy(address, rx_buffer_, size);
-        if (type == SYSEX_OBJECT_TYPE_SEQUENCE_BLOCK_2) {
+        // The CCs received before the object must not overwrite it.
+        parameter_manager.DiscardQueuedValues();
+        // A pending save of the sequence slot would encode the sequence while
+        // the block is being copied, and could commit it half-copied. It is
+        // cancelled, and restarted once the block is in place.
+        bool saving_sequence = false;
+        if (type == SYSEX_OBJECT_TYPE_SEQUENCE_BLOCK_1 ||
+            type == SYSEX_OBJECT_TYPE_SEQUENCE_BLOCK_2) {
+          saving_sequence = voice_controller.CancelSaveSequence();
+        }
+        memcpy(GetObjectAddress(type), rx_staging_buffer_, rx_expected_size_);
+        if (saving_sequence || type == SYSEX_OBJECT_TYPE_SEQUENCE_BLOCK_2) {
           voice_controller.SaveSequence();
         } else if (type == SYSEX_OBJECT_TYPE_SYSTEM_SETTINGS) {
           system_settings.Save();
@@ -166,14 +391,31 @@ void SysExHandler::AcceptBuffer() {
       };
       break;
     case 0x11:  // Request
-      BulkDump();
+      BulkDump(false);
+      break;
+    case 0x31:  // Packed request
+      BulkDump(true);
+      break;
+    case 0x12:  // Diagnostic request
+      // Sent by Refresh() after the objects of the dump in progress, if any,
+      // so that the messages are not interleaved.
+      pending_report_ = rx_command_[1];
+      if (!dumping()) {
+        StartDumpMessage();
+      }
       break;
   }
 }
 
+/* static */
+void SysExHandler::Abort() {
+  rx_state_ = RECEPTION_ERROR;
+}
+
 /* static */
 void SysExHandler::Receive(uint8_t rx_byte) {
   if (rx_byte == 0xf0) {
+    Abort();
     rx_checksum_ = 0;
     rx_bytes_received_ = 0;
     rx_state_ = RECEIVING_HEADER;
@@ -188,7 +430,7 @@ void SysExHandler::Receive(uint8_t rx_byte) {
           rx_bytes_received_ = 0;
         }
       } else {
-        rx_state_ = RECEIVING_FOOTER;
+        rx_state_ = RECEPTION_ERROR;
       }
       break;
 
@@ -200,31 +442,42 @@ void SysExHandler::Receive(uint8_t rx_byte) {
       break;
 
     case RECEIVING_DATA:
-      {
-        uint16_t i = rx_bytes_received_ >> 1;
-        if (rx_bytes_received_ & 1) {
-          rx_destination_[i] |= rx_byte & 0xf;
-          if (i < rx_expected_size_) {
-            rx_checksum_ += rx_destination_[i];
-          }
+      // Each group starts with a byte holding the high bits of the bytes in
+      // the group: one byte of 4 bits for nibbles, 7 bytes of 1 bit for packed
+      // data.
+      if ((rx_bytes_received_ & rx_group_mask_) == 0) {
+        rx_high_bits_ = rx_byte;
+      } else {
+        uint8_t value;
+        if (rx_group_mask_ == 1) {
+          value = U8ShiftLeft4(rx_high_bits_) | (rx_byte & 0xf);
         } else {
-          rx_destination_[i] = U8ShiftLeft4(rx_byte);
+          value = rx_byte | (rx_high_bits_ & 1 ? 0x80 : 0);
+          rx_high_bits_ >>= 1;
         }
-        rx_bytes_received_++;
-        if (rx_bytes_received_ >= (1 + rx_expected_size_) * 2) {
+        if (rx_data_index_ < rx_expected_size_) {
+          rx_staging_buffer_[rx_data_index_] = value;
+          rx_checksum_ += value;
+        } else {
+          rx_received_checksum_ = value;
           rx_state_ = RECEIVING_FOOTER;
         }
+        ++rx_data_index_;
       }
-    break;
+      rx_bytes_received_++;
+      break;
 
-  case RECEIVING_FOOTER:
-    if (rx_byte == 0xf7 &&
-        rx_checksum_ == rx_destination_[rx_expected_size_]) {
-      AcceptBuffer();
-    } else {
-      rx_state_ = RECEPTION_ERROR;
-    }
-    break;
+    case RECEIVING_FOOTER:
+      if (rx_byte == 0xf7 && rx_checksum_ == rx_received_checksum_) {
+        rx_state_ = RECEPTION_OK;
+        AcceptBuffer();
+      } else {
+        Abort();
+      }
+      break;
+      
+    default:
+      break;
   }
 }
 
@@ -18,6 +18,9 @@
 
 #include "avrlib/base.h"
 
+#include "anu/diagnostics.h"
+#include "anu/profiler.h"
+
 namespace anu {
   
 enum SysExReceptionState {
@@ -38,26 +41,95 @@ enum SysExObjectType {
   SYSEX_OBJECT_TYPE_LAST
 };
 
+enum SysExDiagnosticType {
+  SYSEX_DIAGNOSTIC_TYPE_PROFILER,
+  SYSEX_DIAGNOSTIC_TYPE_BUFFERS,
+  SYSEX_DIAGNOSTIC_TYPE_MEMORY,
+  SYSEX_DIAGNOSTIC_TYPE_LATENCY,
+  SYSEX_DIAGNOSTIC_TYPE_LAST
+};
+
+// Size of the largest object, the first sequence block.
+static const uint8_t kSysExStagingBufferSize = 128;
+
+// Copy of the diagnostic report being sent. The latency histograms are sent
+// from the latency meter, which is frozen while they are sent.
+union SysExReport {
+#ifdef ENABLE_PROFILER
+  ProfilerReport profiler;
+#endif  // ENABLE_PROFILER
+  DiagnosticReport diagnostics;
+  MemoryReport memory;
+};
+
 class SysExHandler {
  public:
-  static void BulkDump();
+  // Starts a dump of all objects, which is then sent by Refresh(). With
+  // packed, the data is sent with 7-bit packing rather than nibbles.
+  static void BulkDump(bool packed);
+  // Queues the next bytes of the dump in progress, if any, as long as there is
+  // room for them in the MIDI out buffer. Diagnostic reports are sent the same
+  // way, once the objects of the dump in progress have been sent. The MIDI
+  // messages held back by the dispatcher during a SysEx message are released
+  // before the next one.
+  static void Refresh();
+  // Sends the rest of the SysEx message being dumped, waiting for room in the
+  // MIDI out buffer.
+  static void FinishMessage();
+  static inline bool dumping() { return dump_data_ != NULL; }
+  static bool busy();
+  
   static void Receive(uint8_t sysex_rx_byte);
+  // Cancels the reception in progress, for example when the SysEx message is
+  // interrupted by a status byte.
+  static void Abort();
   
  private:
   static void ParseCommand();
   static void AcceptBuffer();
+  static void StartDumpMessage();
+  static uint8_t NextDumpByte();
+  static uint8_t LoadDumpGroup(uint8_t start);
 
   static void* GetObjectAddress(SysExObjectType type);
   static uint8_t GetObjectSize(SysExObjectType type);
   
-  static uint8_t rx_buffer_[129];
-  static uint8_t* rx_destination_;
+  // Objects are decoded into the staging buffer, and copied into the target
+  // object once the transfer is complete, so a failed transfer leaves the
+  // object untouched.
+  static uint8_t rx_staging_buffer_[kSysExStagingBufferSize];
   static uint16_t rx_bytes_received_;
+  static uint16_t rx_data_index_;
   static uint16_t rx_expected_size_;
   static SysExReceptionState rx_state_;
   static uint8_t rx_checksum_;
+  static uint8_t rx_received_checksum_;
+  // High nibble of the byte being decoded, or MSBs of the 7-byte group being
+  // decoded. rx_group_mask_ is 1 for nibbles and 7 for packed data.
+  static uint8_t rx_high_bits_;
+  static uint8_t rx_group_mask_;
   static uint8_t rx_command_[2];
   
+  // Command, argument and data of the SysEx message being dumped, position in
+  // the message, and the byte being sent as two nibbles (or the group of 7
+  // bytes being sent packed).
+  static uint8_t dump_command_;
+  static uint8_t dump_argument_;
+  static const uint8_t* dump_data_;
+  static uint8_t dump_size_;
+  static uint16_t dump_position_;
+  static uint8_t dump_checksum_;
+  static uint8_t dump_group_[7];
+  
+  // Next object of the bulk dump in progress.
+  static uint8_t dump_object_;
+  static bool dump_packed_;
+  
+  // Diagnostic report to send once the objects of the dump in progress have
+  // been sent, and copy of the report being sent.
+  static uint8_t pending_report_;
+  static SysExReport report_;
+  
   DISALLOW_COPY_AND_ASSIGN(SysExHandler);
 };
 
@@ -31,10 +31,7 @@ uint8_t clock_ppqn;
 uint8_t reference_note;
 uint8_t padding[2];
 
-uint16_t vco_cv_offset;
-uint16_t vco_cv_scale_low;
-uint16_t vco_cv_scale_high;
-uint8_t more_padding[3];
+uint8_t more_padding[2];
 
 /* extern */
 const prog_SystemSettingsData init_settings PROGMEM = {
@@ -53,15 +50,69 @@ const prog_SystemSettingsData init_settings PROGMEM = {
   // Padding
   0, 0,
   
-  // VCO calibration data
-  60 * 128,
-  64000 / 3, 
-  64000 / 3,
+  // VCO calibration data: 64000 / 3 DAC codes per 1024 pitch units, with
+  // pitch 60 * 128 mapped to 2048.
+  {
+    -452, -119, 214, 548, 881, 1214, 1548, 1881, 2214,
+    2547, 2881, 3214, 3547, 3881, 4214, 4547, 4881
+  },
   
   // Padding
-  0, 0, 0
+  0, 0
 };
 
+// Layout of the settings stored by older firmware. The VCO CV was computed as
+// 2048 + (pitch - vco_cv_offset) * scale >> 16, with scale_low below pitch
+// 60 * 128 and scale_high above.
+struct LegacySystemSettingsData {
+  uint8_t midi_channel;
+  uint8_t midi_out_mode;
+  uint8_t clock_ppqn;
+  uint8_t reference_note;
+  uint8_t padding[2];
+  
+  uint16_t vco_cv_offset;
+  uint16_t vco_cv_scale_low;
+  uint16_t vco_cv_scale_high;
+  uint8_t more_padding[3];
+};
+
+static const uint16_t kLegacySystemSettingsAddress = 1000;
+
+/* static */
+void SystemSettings::Init() {
+  if (storage.Read(
+          &data_,
+          StorageLayout<SystemSettingsData>::eeprom_address(),
+          sizeof(data_))) {
+    return;
+  }
+  memcpy_P(&data_, &init_settings, sizeof(data_));
+  
+  // The legacy block starts inside the current one, so it is only intact
+  // until the settings are saved for the first time.
+  LegacySystemSettingsData legacy;
+  if (!storage.Read(
+          &legacy,
+          (uint8_t*)(kLegacySystemSettingsAddress),
+          sizeof(legacy))) {
+    return;
+  }
+  data_.midi_channel = legacy.midi_channel;
+  data_.midi_out_mode = legacy.midi_out_mode;
+  data_.clock_ppqn = legacy.clock_ppqn;
+  data_.reference_note = legacy.reference_note;
+  for (uint8_t i = 0; i < kNumVcoCvCalibrationPoints; ++i) {
+    int32_t pitch = static_cast<int32_t>(i) << kVcoCvCalibrationShift;
+    uint16_t scale = pitch < 60 * 128
+        ? legacy.vco_cv_scale_low
+        : legacy.vco_cv_scale_high;
+    data_.vco_cv_calibration[i] = 2048 + \
+        ((pitch - static_cast<int16_t>(legacy.vco_cv_offset)) * scale >> 16);
+  }
+  storage.Save(data_);
+}
+
 /* extern */
 SystemSettings system_settings;
 
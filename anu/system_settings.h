@@ -18,6 +18,9 @@
 
 #include "avrlib/base.h"
 
+#include <avr/pgmspace.h>
+#include <string.h>
+
 #include "anu/storage.h"
 
 namespace anu {
@@ -30,6 +33,11 @@ enum MidiOutBitmask {
   MIDI_OUT_TX_CONTROLLERS = 16
 };
 
+// The VCO CV calibration table gives the DAC code for pitches 0, 1024, 2048
+// ... 16384 (a point every 8 semitones), and is linearly interpolated.
+const uint8_t kNumVcoCvCalibrationPoints = 17;
+const uint8_t kVcoCvCalibrationShift = 10;
+
 struct SystemSettingsData {
   uint8_t midi_channel;
   uint8_t midi_out_mode;
@@ -37,10 +45,8 @@ struct SystemSettingsData {
   uint8_t reference_note;
   uint8_t padding[2];
   
-  uint16_t vco_cv_offset;
-  uint16_t vco_cv_scale_low;
-  uint16_t vco_cv_scale_high;
-  uint8_t more_padding[3];
+  int16_t vco_cv_calibration[kNumVcoCvCalibrationPoints];
+  uint8_t more_padding[2];
 };
 
 typedef SystemSettingsData PROGMEM prog_SystemSettingsData;
@@ -49,7 +55,7 @@ extern const prog_SystemSettingsData init_settings PROGMEM;
 template<>
 struct StorageLayout<SystemSettingsData> {
   static uint8_t* eeprom_address() { 
-    return (uint8_t*)(1000);
+    return (uint8_t*)(960);
   }
   static const prog_char* init_data() {
     return (prog_char*)&init_settings;
@@ -60,9 +66,9 @@ class SystemSettings {
  public:
   SystemSettings() { }
   
-  static void Init() {
-    storage.Load(&data_);
-  }
+  // Settings stored by older firmware, at another address and with a linear
+  // VCO calibration, are converted when no valid settings are found.
+  static void Init();
   
   static void ResetToFactoryDefaults() {
     storage.ResetToFactoryDefaults(&data_);
@@ -79,9 +85,9 @@ class SystemSettings {
   static inline uint8_t midi_out_mode() { return data_.midi_out_mode; }
   static inline uint8_t clock_ppqn() { return data_.clock_ppqn; }
   static inline uint8_t reference_note() { return data_.reference_note; }
-  static inline int16_t vco_cv_offset() { return data_.vco_cv_offset; }
-  static inline uint16_t vco_cv_scale_low() { return data_.vco_cv_scale_low; }
-  static inline uint16_t vco_cv_scale_high() { return data_.vco_cv_scale_high; }
+  static inline const int16_t* vco_cv_calibration() {
+    return data_.vco_cv_calibration;
+  }
 
   static void ChangePpqn() {
     ++data_.clock_ppqn;
@@ -91,10 +97,19 @@ class SystemSettings {
     storage.Save(data_);
   }
   
-  static void set_calibration_data(uint16_t a, uint16_t b, uint16_t c) {
-    data_.vco_cv_offset = a;
-    data_.vco_cv_scale_low = b;
-    data_.vco_cv_scale_high = c;
+  static void set_vco_cv_calibration(const int16_t* calibration) {
+    memcpy(
+        data_.vco_cv_calibration,
+        calibration,
+        sizeof(data_.vco_cv_calibration));
+    storage.Save(data_);
+  }
+  
+  static void ResetVcoCvCalibration() {
+    memcpy_P(
+        data_.vco_cv_calibration,
+        init_settings.vco_cv_calibration,
+        sizeof(data_.vco_cv_calibration));
     storage.Save(data_);
   }
   
@@ -0,0 +1,533 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host benchmark for the DSP code. Checks the fixed-point primitives against
+// wide integer arithmetic and measures them. Then renders a fixed drum
+// pattern with the DrumSynth and a fixed note sequence with the Voice,
+// measures the time spent per audio block and per DAC state sample, and dumps
+// the rendered streams. The digests of the streams are compared with the
+// committed digests of the current output, so that an optimization which is
+// not bit-exact fails the run. They are not those of the original
+// implementation, and are updated only by changes meant to alter the output.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#include "avrlib/random.h"
+#include "avrlib/time.h"
+
+#include "anu/audio_buffer.h"
+#include "anu/drum_synth.h"
+#include "anu/dsp_utils.h"
+#include "anu/resources.h"
+#include "anu/system_settings.h"
+#include "anu/voice.h"
+
+namespace avrlib {
+
+/* static */
+uint16_t Random::rng_state_ = 0x21;
+
+static uint32_t milliseconds_ = 0;
+
+uint32_t milliseconds() {
+  return milliseconds_;
+}
+
+void TickSystemClock() {
+  ++milliseconds_;
+}
+
+}  // namespace avrlib
+
+using namespace anu;
+using namespace avrlib;
+
+Voice voice;
+
+static const uint32_t kNumDrumBlocks = 24000;
+static const uint32_t kNumDACStateSamples = 120000;
+
+// One step of the drum pattern every 40 blocks (~30ms).
+static const uint8_t kDrumStepDuration = 40;
+
+// Digests of the rendered streams, to be updated only by changes which are
+// meant to alter the output.
+static const uint32_t kDrumSynthDigestBandwidth255 = 0x6d6ddaa0;
+static const uint32_t kDrumSynthDigestBandwidth128 = 0x61d8e275;
+static const uint32_t kDrumSynthDigestHhSample = 0x7d8a8a3a;
+static const uint32_t kVoiceDigest = 0x4c7ef33d;
+
+// BD, SD, HH patterns as 16-step bitmasks.
+static const uint16_t drum_pattern[kNumDrumInstruments] = {
+  0x1111, 0x1010, 0xeeee
+};
+
+// Timings are taken on the host, not on the ATmega328: they are x86 TSC ticks,
+// or nanoseconds on other hosts. They only compare versions of the code.
+#if defined(__i386__) || defined(__x86_64__)
+static const char kTimeUnit[] = "x86 cycles";
+#else
+static const char kTimeUnit[] = "host ns";
+#endif
+
+static inline uint64_t ReadCycleCounter() {
+#if defined(__i386__) || defined(__x86_64__)
+  return __rdtsc();
+#else
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return static_cast<uint64_t>(t.tv_sec) * 1000000000ULL + t.tv_nsec;
+#endif
+}
+
+class Digest {
+ public:
+  Digest() : hash_(2166136261U) { }
+
+  void Update(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    while (size--) {
+      hash_ ^= *bytes++;
+      hash_ *= 16777619U;
+    }
+  }
+
+  uint32_t value() const { return hash_; }
+
+ private:
+  uint32_t hash_;
+};
+
+class Output {
+ public:
+  Output(const char* directory, const char* name) : file_(NULL) {
+    if (!directory) {
+      return;
+    }
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/%s", directory, name);
+    file_ = fopen(path, "wb");
+    if (!file_) {
+      fprintf(stderr, "Cannot open %s for writing\n", path);
+      exit(1);
+    }
+  }
+
+  ~Output() {
+    if (file_) {
+      fclose(file_);
+    }
+  }
+
+  void Write(const void* data, size_t size) {
+    if (file_) {
+      fwrite(data, 1, size, file_);
+    }
+    digest_.Update(data, size);
+  }
+
+  uint32_t digest() const { return digest_.value(); }
+
+ private:
+  FILE* file_;
+  Digest digest_;
+};
+
+// Each primitive is checked on all its cases, or on a pseudo-random subset of
+// them when there are too many. The argument values are unpacked from the
+// case number, which is part of the measured time, on all primitives alike.
+static const uint32_t kNumRandomCases = 1 << 22;
+static const uint32_t kNumPrimitiveCalls = 1 << 24;
+
+static inline uint32_t Scramble(uint32_t i) {
+  i ^= i >> 16;
+  i *= 0x7feb352dU;
+  i ^= i >> 15;
+  i *= 0x846ca68bU;
+  return i ^ (i >> 16);
+}
+
+struct TestU8U8MulShift8 {
+  enum { num_cases = 1 << 16 };
+  static int32_t Compute(uint32_t i) {
+    return U8U8MulShift8(i, i >> 8);
+  }
+  static int32_t Reference(uint32_t i) {
+    return ((i & 0xff) * ((i >> 8) & 0xff)) >> 8;
+  }
+};
+
+struct TestS8U8MulShift8 {
+  enum { num_cases = 1 << 16 };
+  static int32_t Compute(uint32_t i) {
+    return S8U8MulShift8(i, i >> 8);
+  }
+  static int32_t Reference(uint32_t i) {
+    int32_t a = static_cast<int8_t>(i);
+    int32_t b = (i >> 8) & 0xff;
+    return (a * b) >> 8;
+  }
+};
+
+struct TestU16U8MulShift8 {
+  enum { num_cases = 1 << 24 };
+  static int32_t Compute(uint32_t i) {
+    return U16U8MulShift8(i, i >> 16);
+  }
+  static int32_t Reference(uint32_t i) {
+    return ((i & 0xffff) * ((i >> 16) & 0xff)) >> 8;
+  }
+};
+
+struct TestS16U8MulShift8 {
+  enum { num_cases = 1 << 24 };
+  static int32_t Compute(uint32_t i) {
+    return S16U8MulShift8(i, i >> 16);
+  }
+  static int32_t Reference(uint32_t i) {
+    int32_t a = static_cast<int16_t>(i);
+    int32_t b = (i >> 16) & 0xff;
+    return (a * b) >> 8;
+  }
+};
+
+struct TestU16U16MulShift16 {
+  enum { num_cases = kNumRandomCases };
+  static int32_t Compute(uint32_t i) {
+    i = Scramble(i);
+    return U16U16MulShift16(i, i >> 16);
+  }
+  static int32_t Reference(uint32_t i) {
+    i = Scramble(i);
+    return (static_cast<uint64_t>(i & 0xffff) * (i >> 16)) >> 16;
+  }
+};
+
+struct TestU32U16MulShift16 {
+  enum { num_cases = kNumRandomCases };
+  static int32_t Compute(uint32_t i) {
+    return U32U16MulShift16(Scramble(i), Scramble(~i));
+  }
+  static int32_t Reference(uint32_t i) {
+    uint64_t product = static_cast<uint64_t>(Scramble(i)) * \
+        (Scramble(~i) & 0xffff);
+    return static_cast<uint32_t>(product >> 16);
+  }
+};
+
+struct TestU8Mix {
+  enum { num_cases = 1 << 24 };
+  static int32_t Compute(uint32_t i) {
+    return U8Mix(i, i >> 8, i >> 16);
+  }
+  static int32_t Reference(uint32_t i) {
+    uint32_t a = i & 0xff;
+    uint32_t b = (i >> 8) & 0xff;
+    uint32_t balance = (i >> 16) & 0xff;
+    return (a * (255 - balance) + b * balance) >> 8;
+  }
+};
+
+// Both Mix() variants round the interpolated value towards a.
+struct TestMixS16 {
+  enum { num_cases = kNumRandomCases };
+  static int32_t Compute(uint32_t i) {
+    uint32_t x = Scramble(i);
+    return Mix(static_cast<int16_t>(x), static_cast<int16_t>(x >> 16),
+               static_cast<uint16_t>(Scramble(~i)));
+  }
+  static int32_t Reference(uint32_t i) {
+    uint32_t x = Scramble(i);
+    int32_t a = static_cast<int16_t>(x);
+    int32_t b = static_cast<int16_t>(x >> 16);
+    int64_t balance = Scramble(~i) & 0xffff;
+    return b > a
+        ? a + static_cast<int32_t>(((b - a) * balance) >> 16)
+        : a - static_cast<int32_t>(((a - b) * balance) >> 16);
+  }
+};
+
+struct TestMixU16 {
+  enum { num_cases = kNumRandomCases };
+  static int32_t Compute(uint32_t i) {
+    uint32_t x = Scramble(i);
+    return Mix(static_cast<uint16_t>(x), static_cast<uint16_t>(x >> 16),
+               static_cast<uint16_t>(Scramble(~i)));
+  }
+  static int32_t Reference(uint32_t i) {
+    uint32_t x = Scramble(i);
+    int32_t a = x & 0xffff;
+    int32_t b = x >> 16;
+    int64_t balance = Scramble(~i) & 0xffff;
+    return b > a
+        ? a + static_cast<int32_t>(((b - a) * balance) >> 16)
+        : a - static_cast<int32_t>(((a - b) * balance) >> 16);
+  }
+};
+
+struct TestInterpolateSample {
+  enum { num_cases = 1 << 16 };
+  static int32_t Compute(uint32_t i) {
+    return InterpolateSample(wav_res_sine, i);
+  }
+  static int32_t Reference(uint32_t i) {
+    uint32_t a = wav_res_sine[(i >> 8) & 0xff];
+    uint32_t b = wav_res_sine[((i >> 8) & 0xff) + 1];
+    uint32_t balance = i & 0xff;
+    return (a * (255 - balance) + b * balance) >> 8;
+  }
+};
+
+struct TestInterpolateIncreasing {
+  enum { num_cases = 1 << 16 };
+  static int32_t Compute(uint32_t i) {
+    return InterpolateIncreasing(lut_res_log2, i);
+  }
+  static int32_t Reference(uint32_t i) {
+    uint32_t a = lut_res_log2[(i >> 8) & 0xff];
+    uint32_t b = lut_res_log2[((i >> 8) & 0xff) + 1];
+    return a + (((b - a) * (i & 0xff)) >> 8);
+  }
+};
+
+struct TestDecodeExponent {
+  enum { num_cases = 1 << 16 };
+  static int32_t Compute(uint32_t i) {
+    return DecodeExponent(i);
+  }
+  static int32_t Reference(uint32_t i) {
+    uint64_t mantissa = (i & 0x0fff) | 0x1000;
+    return static_cast<uint32_t>(mantissa << ((i >> 12) & 0xf));
+  }
+};
+
+template<typename Primitive>
+static bool TestPrimitive(const char* name, bool verbose) {
+  uint32_t num_errors = 0;
+  for (uint32_t i = 0; i < static_cast<uint32_t>(Primitive::num_cases); ++i) {
+    if (Primitive::Compute(i) != Primitive::Reference(i)) {
+      if (!num_errors) {
+        fprintf(stderr, "%s: case %u, got %d instead of %d\n",
+                name, i, Primitive::Compute(i), Primitive::Reference(i));
+      }
+      ++num_errors;
+    }
+  }
+  
+  // The sum of the results is printed so that the calls are not optimized
+  // away.
+  int32_t sum = 0;
+  uint64_t start = ReadCycleCounter();
+  for (uint32_t i = 0; i < kNumPrimitiveCalls; ++i) {
+    sum += Primitive::Compute(i);
+  }
+  uint64_t total_cycles = ReadCycleCounter() - start;
+  
+  if (verbose) {
+    printf("%-26s %8.2f %s/call, %s (%08x)\n",
+           name,
+           static_cast<double>(total_cycles) / kNumPrimitiveCalls,
+           kTimeUnit,
+           num_errors ? "MISMATCH" : "bit-exact",
+           sum);
+  }
+  return num_errors == 0;
+}
+
+static bool TestPrimitives(bool verbose) {
+  bool ok = true;
+  ok &= TestPrimitive<TestU8U8MulShift8>("U8U8MulShift8", verbose);
+  ok &= TestPrimitive<TestS8U8MulShift8>("S8U8MulShift8", verbose);
+  ok &= TestPrimitive<TestU16U8MulShift8>("U16U8MulShift8", verbose);
+  ok &= TestPrimitive<TestS16U8MulShift8>("S16U8MulShift8", verbose);
+  ok &= TestPrimitive<TestU16U16MulShift16>("U16U16MulShift16", verbose);
+  ok &= TestPrimitive<TestU32U16MulShift16>("U32U16MulShift16", verbose);
+  ok &= TestPrimitive<TestU8Mix>("U8Mix", verbose);
+  ok &= TestPrimitive<TestMixS16>("Mix (int16_t)", verbose);
+  ok &= TestPrimitive<TestMixU16>("Mix (uint16_t)", verbose);
+  ok &= TestPrimitive<TestInterpolateSample>("InterpolateSample", verbose);
+  ok &= TestPrimitive<TestInterpolateIncreasing>(
+      "InterpolateIncreasing", verbose);
+  ok &= TestPrimitive<TestDecodeExponent>("DecodeExponent", verbose);
+  return ok;
+}
+
+static void DrainAudioBuffer(Output* output, uint8_t num_samples) {
+  while (num_samples-- && audio_buffer.readable()) {
+    uint8_t sample = audio_buffer.ImmediateRead();
+    output->Write(&sample, 1);
+  }
+}
+
+static bool CheckDigest(uint32_t digest, uint32_t expected) {
+  if (digest != expected) {
+    printf("  digest mismatch, %08x expected\n", expected);
+    return false;
+  }
+  return true;
+}
+
+// With hh_sample, the hi-hat is played from one of the samples, at its
+// original rate, instead of being synthesized.
+static uint32_t BenchmarkDrumSynth(
+    const char* directory,
+    uint8_t bandwidth,
+    bool hh_sample) {
+  char name[64];
+  snprintf(name, sizeof(name), "drums_bw%d%s.raw", bandwidth,
+           hh_sample ? "_hh_sample" : "");
+  Output output(directory, name);
+
+  Random::Seed(0x21);
+  audio_buffer.Flush();
+  drum_synth.Init();
+  for (uint8_t i = 0; i < kNumDrumInstruments; ++i) {
+    drum_synth.MorphPatch(i, 40 + i * 60);
+  }
+  if (hh_sample) {
+    drum_synth.MorphPatch(2, 224);
+  }
+  drum_synth.SetBalance(128);
+  drum_synth.SetBandwidth(bandwidth);
+
+  // Prime the buffer, so that each subsequent call to Render() renders
+  // exactly one block.
+  drum_synth.Render();
+
+  uint64_t total_cycles = 0;
+  for (uint32_t block = 0; block < kNumDrumBlocks; ++block) {
+    if (block % kDrumStepDuration == 0) {
+      uint8_t step = (block / kDrumStepDuration) & 0xf;
+      for (uint8_t i = 0; i < kNumDrumInstruments; ++i) {
+        if (drum_pattern[i] & (1 << step)) {
+          drum_synth.Trigger(i, 128 + (step << 3));
+        }
+      }
+    }
+    DrainAudioBuffer(&output, kAudioBlockSize);
+    uint64_t start = ReadCycleCounter();
+    drum_synth.Render();
+    total_cycles += ReadCycleCounter() - start;
+    TickSystemClock();
+  }
+  DrainAudioBuffer(&output, 0xff);
+
+  if (directory) {
+    printf("DrumSynth::Render (bandwidth %3d%s): %8.1f %s/block, "
+           "digest %08x\n",
+           bandwidth,
+           hh_sample ? ", HH sample" : "",
+           static_cast<double>(total_cycles) / kNumDrumBlocks,
+           kTimeUnit,
+           output.digest());
+  }
+  return output.digest();
+}
+
+static uint32_t BenchmarkVoice(const char* directory) {
+  Output output(directory, "cv.raw");
+
+  Random::Seed(0x21);
+  system_settings.Init();
+  voice.Init();
+  voice.SetValue(PRM_PATCH_VCO_ENV_AMOUNT, 32);
+  voice.SetValue(PRM_PATCH_VCO_LFO_AMOUNT, 24);
+  voice.SetValue(PRM_PATCH_PW_ENV_AMOUNT, 96);
+  voice.SetValue(PRM_PATCH_CUTOFF_ENV_AMOUNT, 160);
+  voice.SetValue(PRM_PATCH_CUTOFF_LFO_AMOUNT, 48);
+  voice.SetValue(PRM_PATCH_ENV_ATTACK, 20);
+  voice.SetValue(PRM_PATCH_ENV_DECAY, 90);
+  voice.SetValue(PRM_PATCH_ENV_SUSTAIN, 100);
+  voice.SetValue(PRM_PATCH_ENV_RELEASE, 80);
+  voice.SetValue(PRM_PATCH_KBD_GLIDE, 40);
+  voice.ControlChange(1, 40);
+
+  uint64_t total_cycles = 0;
+  uint32_t num_samples = 0;
+  uint32_t next_event = 0;
+  uint8_t event = 0;
+  while (num_samples < kNumDACStateSamples) {
+    if (num_samples >= next_event) {
+      uint8_t note = 36 + ((event * 7) % 36);
+      if (event & 1) {
+        voice.NoteOff(note);
+      } else {
+        voice.NoteOn(note, 100, (event & 6) ? 0 : 0x60, event & 8 ? 0x70 : 0,
+                     event & 4);
+      }
+      if ((event & 31) == 16) {
+        voice.SetValue(PRM_PATCH_LFO_SHAPE, (event >> 5) % LFO_SHAPE_LAST);
+        voice.PitchBend(8192 + ((event & 64) ? 1024 : -1024));
+      }
+      ++event;
+      next_event += 1000 + (event & 3) * 300;
+    }
+    uint64_t start = ReadCycleCounter();
+    voice.Refresh();
+    total_cycles += ReadCycleCounter() - start;
+    while (voice.readable()) {
+      voice.ReadDACStateSample();
+      const DACState& state = voice.dac_state();
+      uint16_t cv[4] = {
+        state.vco_cv, state.pw_cv, state.vcf_cv, state.vca_cv
+      };
+      output.Write(cv, sizeof(cv));
+      ++num_samples;
+    }
+  }
+
+  if (directory) {
+    printf("Voice::WriteDACStateSample:        %8.1f %s/sample, "
+           "digest %08x\n",
+           static_cast<double>(total_cycles) / num_samples,
+           kTimeUnit,
+           output.digest());
+  }
+  return output.digest();
+}
+
+int main(int argc, char** argv) {
+  const char* directory = argc > 1 ? argv[1] : ".";
+
+  if (!TestPrimitives(true)) {
+    return 1;
+  }
+
+  // Warm-up pass, to get the tables and code in the cache.
+  BenchmarkDrumSynth(NULL, 255, false);
+  BenchmarkVoice(NULL);
+
+  bool ok = true;
+  ok &= CheckDigest(
+      BenchmarkDrumSynth(directory, 255, false),
+      kDrumSynthDigestBandwidth255);
+  ok &= CheckDigest(
+      BenchmarkDrumSynth(directory, 128, false),
+      kDrumSynthDigestBandwidth128);
+  ok &= CheckDigest(
+      BenchmarkDrumSynth(directory, 255, true),
+      kDrumSynthDigestHhSample);
+  ok &= CheckDigest(BenchmarkVoice(directory), kVoiceDigest);
+  return ok ? 0 : 1;
+}
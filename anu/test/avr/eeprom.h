@@ -0,0 +1,63 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host shim for avr-libc's EEPROM accessors, backed by a RAM array which
+// starts erased (0xff), like a virgin chip.
+
+#ifndef ANU_TEST_AVR_EEPROM_H_
+#define ANU_TEST_AVR_EEPROM_H_
+
+#include <inttypes.h>
+#include <string.h>
+
+namespace avr_shim {
+
+static const uint16_t kEepromSize = 1024;
+
+inline uint8_t* eeprom() {
+  static uint8_t data[kEepromSize];
+  static bool initialized = false;
+  if (!initialized) {
+    memset(data, 0xff, kEepromSize);
+    initialized = true;
+  }
+  return data;
+}
+
+inline uint16_t eeprom_offset(const void* address) {
+  return static_cast<uint16_t>(reinterpret_cast<uintptr_t>(address));
+}
+
+}  // namespace avr_shim
+
+inline void eeprom_read_block(void* data, const void* address, size_t size) {
+  memcpy(data, avr_shim::eeprom() + avr_shim::eeprom_offset(address), size);
+}
+
+inline void eeprom_write_block(const void* data, void* address, size_t size) {
+  memcpy(avr_shim::eeprom() + avr_shim::eeprom_offset(address), data, size);
+}
+
+inline uint8_t eeprom_read_byte(const uint8_t* address) {
+  return avr_shim::eeprom()[avr_shim::eeprom_offset(address)];
+}
+
+inline void eeprom_write_byte(uint8_t* address, uint8_t value) {
+  avr_shim::eeprom()[avr_shim::eeprom_offset(address)] = value;
+}
+
+#endif  // ANU_TEST_AVR_EEPROM_H_
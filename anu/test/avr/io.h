@@ -0,0 +1,37 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host shim for the few AVR registers used by the code under test. The EEPROM
+// is always ready, so background saves complete when Storage::Flush() is
+// called.
+
+#ifndef ANU_TEST_AVR_IO_H_
+#define ANU_TEST_AVR_IO_H_
+
+#include <inttypes.h>
+
+#ifndef _BV
+#define _BV(bit) (1 << (bit))
+#endif  // _BV
+
+static volatile uint8_t SREG;
+static volatile uint8_t EECR;
+
+#define EERIE 3
+#define EEPE 1
+
+#endif  // ANU_TEST_AVR_IO_H_
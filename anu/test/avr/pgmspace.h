@@ -0,0 +1,62 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host shim for avr-libc's program memory accessors. Flash and RAM share the
+// same address space on the host, so all accessors are plain loads.
+
+#ifndef ANU_TEST_AVR_PGMSPACE_H_
+#define ANU_TEST_AVR_PGMSPACE_H_
+
+#include <inttypes.h>
+#include <string.h>
+
+#define PROGMEM
+
+typedef char prog_char;
+typedef uint8_t prog_uint8_t;
+typedef int8_t prog_int8_t;
+typedef uint16_t prog_uint16_t;
+typedef int16_t prog_int16_t;
+typedef uint32_t prog_uint32_t;
+typedef int32_t prog_int32_t;
+
+namespace avr_shim {
+
+inline uint8_t ReadByte(const void* address) {
+  return *static_cast<const uint8_t*>(address);
+}
+
+inline uint16_t ReadWord(const void* address) {
+  uint16_t value;
+  memcpy(&value, address, sizeof(value));
+  return value;
+}
+
+inline uint32_t ReadDword(const void* address) {
+  uint32_t value;
+  memcpy(&value, address, sizeof(value));
+  return value;
+}
+
+}  // namespace avr_shim
+
+#define pgm_read_byte(address) avr_shim::ReadByte(address)
+#define pgm_read_word(address) avr_shim::ReadWord(address)
+#define pgm_read_dword(address) avr_shim::ReadDword(address)
+#define memcpy_P memcpy
+
+#endif  // ANU_TEST_AVR_PGMSPACE_H_
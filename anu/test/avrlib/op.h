@@ -0,0 +1,90 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host shim for avrlib/op.h: portable versions of the fixed-point operators.
+// They must stay bit-exact with the AVR assembly versions.
+
+#ifndef ANU_TEST_AVRLIB_OP_H_
+#define ANU_TEST_AVRLIB_OP_H_
+
+#include "avrlib/base.h"
+
+namespace avrlib {
+
+static inline uint8_t U8ShiftRight4(uint8_t a) {
+  return a >> 4;
+}
+
+static inline uint8_t U8ShiftLeft4(uint8_t a) {
+  return a << 4;
+}
+
+static inline uint16_t U16ShiftRight4(uint16_t a) {
+  return a >> 4;
+}
+
+static inline uint8_t U8U8MulShift8(uint8_t a, uint8_t b) {
+  return static_cast<uint16_t>(a) * b >> 8;
+}
+
+static inline int8_t S8U8MulShift8(int8_t a, uint8_t b) {
+  return static_cast<int16_t>(a) * b >> 8;
+}
+
+static inline uint16_t U16U8MulShift8(uint16_t a, uint8_t b) {
+  return static_cast<uint32_t>(a) * b >> 8;
+}
+
+static inline int16_t S16U8MulShift8(int16_t a, uint8_t b) {
+  return static_cast<int32_t>(a) * b >> 8;
+}
+
+static inline uint16_t U16U16MulShift16(uint16_t a, uint16_t b) {
+  return static_cast<uint32_t>(a) * b >> 16;
+}
+
+static inline uint16_t U8U8Mul(uint8_t a, uint8_t b) {
+  return static_cast<uint16_t>(a) * b;
+}
+
+static inline int16_t S8U8Mul(int8_t a, uint8_t b) {
+  return static_cast<int16_t>(a) * b;
+}
+
+static inline int16_t S8S8Mul(int8_t a, int8_t b) {
+  return static_cast<int16_t>(a) * b;
+}
+
+static inline uint8_t U8Mix(uint8_t a, uint8_t b, uint8_t balance) {
+  Word sum;
+  sum.value = U8U8Mul(a, 255 - balance);
+  sum.value += U8U8Mul(b, balance);
+  return sum.bytes[1];
+}
+
+static inline uint8_t InterpolateSample(
+    const prog_uint8_t* table,
+    uint16_t phase) {
+  return U8Mix(
+      pgm_read_byte(table + (phase >> 8)),
+      pgm_read_byte(1 + table + (phase >> 8)),
+      phase & 0xff);
+}
+
+}  // namespace avrlib
+
+#endif  // ANU_TEST_AVRLIB_OP_H_
@@ -0,0 +1,104 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host shim for avrlib/ring_buffer.h. Same static, power-of-two sized
+// interface as the AVR version.
+
+#ifndef ANU_TEST_AVRLIB_RING_BUFFER_H_
+#define ANU_TEST_AVRLIB_RING_BUFFER_H_
+
+#include "avrlib/base.h"
+
+namespace avrlib {
+
+template<uint8_t size> struct DataTypeForSize { typedef uint16_t Type; };
+template<> struct DataTypeForSize<8> { typedef uint8_t Type; };
+
+template<typename Specs>
+class RingBuffer {
+ public:
+  typedef typename Specs::Value Value;
+  enum {
+    size = Specs::buffer_size,
+  };
+
+  RingBuffer() { }
+
+  static inline uint8_t capacity() { return size; }
+  static inline uint8_t writable() {
+    return (read_ptr_ - write_ptr_ - 1) & (size - 1);
+  }
+  static inline uint8_t readable() {
+    return (write_ptr_ - read_ptr_) & (size - 1);
+  }
+
+  static inline void Write(Value v) {
+    while (!writable());
+    Overwrite(v);
+  }
+
+  static inline uint8_t NonBlockingWrite(Value v) {
+    if (writable()) {
+      Overwrite(v);
+      return 1;
+    } else {
+      return 0;
+    }
+  }
+
+  static inline void Overwrite(Value v) {
+    uint8_t w = write_ptr_;
+    buffer_[w] = v;
+    write_ptr_ = (w + 1) & (size - 1);
+  }
+
+  static inline Value Read() {
+    while (!readable());
+    return ImmediateRead();
+  }
+
+  static inline Value ImmediateRead() {
+    uint8_t r = read_ptr_;
+    Value result = buffer_[r];
+    read_ptr_ = (r + 1) & (size - 1);
+    return result;
+  }
+
+  static inline void Flush() {
+    write_ptr_ = read_ptr_;
+  }
+
+ private:
+  static Value buffer_[size];
+  static volatile uint8_t read_ptr_;
+  static volatile uint8_t write_ptr_;
+
+  DISALLOW_COPY_AND_ASSIGN(RingBuffer);
+};
+
+template<typename Specs>
+typename RingBuffer<Specs>::Value RingBuffer<Specs>::buffer_[];
+
+template<typename Specs>
+volatile uint8_t RingBuffer<Specs>::read_ptr_ = 0;
+
+template<typename Specs>
+volatile uint8_t RingBuffer<Specs>::write_ptr_ = 0;
+
+}  // namespace avrlib
+
+#endif  // ANU_TEST_AVRLIB_RING_BUFFER_H_
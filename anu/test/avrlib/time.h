@@ -0,0 +1,33 @@
+// Copyright 2012 Olivier Gillet.
+//
+// Author: Olivier Gillet (ol.gillet@gmail.com)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// -----------------------------------------------------------------------------
+//
+// Host shim for avrlib/time.h. The system clock only moves when the test
+// harness calls TickSystemClock().
+
+#ifndef ANU_TEST_AVRLIB_TIME_H_
+#define ANU_TEST_AVRLIB_TIME_H_
+
+#include "avrlib/base.h"
+
+namespace avrlib {
+
+uint32_t milliseconds();
+void TickSystemClock();
+
+}  // namespace avrlib
+
+#endif  // ANU_TEST_AVRLIB_TIME_H_
@@ -15,8 +15,11 @@
 
 #include "anu/ui.h"
 
+#include <avr/interrupt.h>
+
 #include "avrlib/adc.h"
 
+#include "anu/diagnostics.h"
 #include "anu/hardware_config.h"
 #include "anu/midi_dispatcher.h"
 #include "anu/parameter.h"
@@ -31,18 +34,35 @@ namespace anu {
 static const uint8_t kNumSoftPots = 10;
 static const uint8_t kNumRows = 3;
 
+// Pot scanning. The pot which has been moved last is the "active" pot, and is
+// read every other scan, the others being swept in turn during the remaining
+// scans. The readings of the active pot are averaged, and its threshold is
+// lowered. The pot is demoted after a number of consecutive readings without
+// movement.
+static const uint8_t kNoActivePot = 0xff;
+static const uint8_t kActivePotThreshold = 2;
+static const uint8_t kActivePotTimeout = 128;
+
 using namespace avrlib;
 
 /* <static> */
 uint8_t Ui::led_pattern_;
 avrlib::EventQueue<16> Ui::queue_;
+uint8_t Ui::pending_pot_value_[kNumPots];
+volatile uint16_t Ui::pending_pots_;
 uint8_t Ui::active_row_ = 0;
 uint8_t Ui::inhibit_switch_ = 0;
 uint8_t Ui::pwm_cycle_;
 uint8_t Ui::display_mode_;
 uint16_t Ui::adc_values_[kNumPots];
 uint8_t Ui::adc_thresholds_[kNumPots];
+uint8_t Ui::adc_noise_[kNumPots];
+uint8_t Ui::adc_last_reading_[kNumPots];
 uint8_t Ui::scanned_pot_;
+uint8_t Ui::swept_pot_ = 1;
+uint8_t Ui::active_pot_ = kNoActivePot;
+uint8_t Ui::active_pot_idle_time_;
+uint16_t Ui::active_pot_average_;
 uint8_t Ui::pot_scanning_warm_up_ = 16;
 bool Ui::busy_ = false;
 bool Ui::snapped_[kNumPots];
@@ -134,30 +154,90 @@ void Ui::Poll() {
     }
   }
   
-  // Read pot value and launch ADC scan.
+  ScanPots();
+}
+
+/* static */
+void Ui::ScanPots() {
+  // Read pot value.
+  uint8_t pot = scanned_pot_;
   uint16_t adc_value = adc.ReadOut();
-  int16_t delta = adc_values_[scanned_pot_] - adc_value;
+  
+  // Estimate the noise of the pot from the difference between consecutive
+  // readings - the low byte is enough for that. adc_noise_ is 8 times the
+  // average absolute difference.
+  int8_t jitter = static_cast<uint8_t>(adc_value) - adc_last_reading_[pot];
+  adc_last_reading_[pot] = adc_value;
+  if (jitter < 0) {
+    jitter = -jitter;
+  }
+  if (jitter > 31) {
+    jitter = 31;
+  }
+  
+  uint8_t threshold;
+  if (pot == active_pot_) {
+    // Average the last 4 readings, the sum being kept in 12 bits.
+    active_pot_average_ += adc_value - (active_pot_average_ >> 2);
+    adc_value = active_pot_average_ >> 2;
+    threshold = (adc_noise_[pot] >> 3) + 1;
+    if (threshold < kActivePotThreshold) {
+      threshold = kActivePotThreshold;
+    }
+  } else {
+    // Hysteresis: twice the average jitter, or the pot's threshold.
+    threshold = (adc_noise_[pot] >> 2) + 1;
+    if (threshold < adc_thresholds_[pot]) {
+      threshold = adc_thresholds_[pot];
+    }
+  }
+  
+  int16_t delta = adc_values_[pot] - adc_value;
   if (delta < 0) {
     delta = -delta;
   }
-  if (delta >= adc_thresholds_[scanned_pot_]) {
-    adc_values_[scanned_pot_] = adc_value;
+  if (delta >= threshold) {
+    adc_values_[pot] = adc_value;
     // Do not post events in the queue until 16 scanning cycles have been
     // performed.
     if (!pot_scanning_warm_up_) {
-      queue_.AddEvent(CONTROL_POT, scanned_pot_, adc_value >> 2);
+      uint16_t mask = static_cast<uint16_t>(1) << pot;
+      if (pending_pots_ & mask) {
+        diagnostics.Count(DIAGNOSTIC_COUNTER_POT_COALESCED);
+      }
+      pending_pot_value_[pot] = adc_value >> 2;
+      pending_pots_ |= mask;
+      if (pot != active_pot_) {
+        active_pot_ = pot;
+        active_pot_average_ = adc_value << 2;
+      }
+      active_pot_idle_time_ = 0;
+    }
+  } else {
+    // Only update the noise estimate when the pot is not being moved.
+    adc_noise_[pot] += jitter - (adc_noise_[pot] >> 3);
+    if (pot == active_pot_ && ++active_pot_idle_time_ == kActivePotTimeout) {
+      active_pot_ = kNoActivePot;
     }
   }
+  
+  // Select the next pot and launch ADC scan.
   mux_bank1_ss.High();
   mux_bank2_ss.High();
-  ++scanned_pot_;
-  if (scanned_pot_ == kNumPots) {
-    scanned_pot_ = 0;
-    if (pot_scanning_warm_up_) {
-      --pot_scanning_warm_up_;
+  if (active_pot_ != kNoActivePot && pot != active_pot_) {
+    pot = active_pot_;
+  } else {
+    pot = swept_pot_;
+    ++swept_pot_;
+    if (swept_pot_ == kNumPots) {
+      swept_pot_ = 0;
+      if (pot_scanning_warm_up_) {
+        --pot_scanning_warm_up_;
+      }
     }
   }
-  uint8_t address = pots_layout[scanned_pot_];
+  scanned_pot_ = pot;
+  uint8_t address = pots_layout[pot];
   if (address & 0x08) {
     mux_bank2_ss.Low();
   } else {
@@ -181,7 +261,12 @@ void Ui::UnlockPot(uint8_t index) {
 /* static */
 void Ui::LockPots(bool snap) {
   queue_.Flush();
+  uint8_t sreg = SREG;
+  cli();
+  pending_pots_ = 0;
+  SREG = sreg;
   memset(adc_thresholds_, 16, kNumSoftPots);
+  active_pot_ = kNoActivePot;
   memset(snapped_, !snap, kNumSoftPots);
   memset(snap_position_cache_, 0xff, sizeof(snap_position_cache_));
   display_snap_delta_ = 0;
@@ -263,7 +348,7 @@ void Ui::HandleSwitchEvent(uint8_t index) {
       break;
       
     case CONTROL_SHIFT_REC_BUTTON:
-      system_settings.set_calibration_data(60 * 128, 64000 / 3, 64000 / 3);
+      system_settings.ResetVcoCvCalibration();
       break;
       
     case CONTROL_SHIFT_LONG_PRESS:
@@ -272,7 +357,7 @@ void Ui::HandleSwitchEvent(uint8_t index) {
       break;
       
     case CONTROL_RUN_STOP_LONG_PRESS:
-      sysex_handler.BulkDump();
+      sysex_handler.BulkDump(false);
       break;
   }
 }
@@ -368,15 +453,36 @@ void Ui::HandlePotEvent(uint8_t index, uint8_t value) {
 
 /* static */
 void Ui::DoEvents() {
+  // The switch events are handled first, in the order they arrived. The
+  // pending pot values are the latest ones, and are handled next. A switch
+  // changing the function of the pots locks them, and drops their pending
+  // values.
   while (queue_.available()) {
     Event e = queue_.PullEvent();
     if (e.control_type == CONTROL_SWITCH) {
       HandleSwitchEvent(e.control_id);
-    } else if (e.control_type == CONTROL_POT) {
-      HandlePotEvent(e.control_id, e.value);
     }
     queue_.Touch();
   }
+  
+  uint8_t sreg = SREG;
+  cli();
+  uint16_t pending_pots = pending_pots_;
+  pending_pots_ = 0;
+  SREG = sreg;
+  if (pending_pots) {
+    for (uint8_t i = 0; i < kNumPots; ++i) {
+      if (pending_pots & 1) {
+        HandlePotEvent(i, pending_pot_value_[i]);
+      }
+      pending_pots >>= 1;
+    }
+    queue_.Touch();
+  }
+  if (strummer_enabled_) {
+    strummer.Tick();
+  }
+  
   if (midi_dispatcher.learning_midi_channel()) {
     display_mode_ = DISPLAY_MODE_MIDI_CHANNEL;
   }
@@ -390,6 +496,24 @@ void Ui::DoEvents() {
   }
 }
 
+/* static */
+bool Ui::idle() {
+  uint8_t sreg = SREG;
+  cli();
+  bool pending_pots = pending_pots_ != 0;
+  SREG = sreg;
+  if (pending_pots || queue_.available() || strummer_enabled_ ||
+      midi_dispatcher.learning_midi_channel()) {
+    return false;
+  }
+  uint32_t idle_time = queue_.idle_time_ms();
+  if (idle_time > 10000) {
+    return false;
+  }
+  return idle_time <= 2500 || (
+      display_mode_ == DISPLAY_MODE_LFO_GATE_CLOCK && !display_snap_delta_);
+}
+
 /* static */
 void Ui::TrySavingSettings() {
   if (voice_controller.at_rest() && drum_synth.idle_time_ms() > 10000) {
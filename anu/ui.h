@@ -16,6 +16,8 @@
 #ifndef ANU_UI_H_
 #define ANU_UI_H_
 
+#include <avr/interrupt.h>
+
 #include "avrlib/base.h"
 #include "avrlib/ui/event_queue.h"
 
@@ -81,8 +83,15 @@ class Ui {
   static void Init();
   static void Poll();
   static void DoEvents();
+  // Whether DoEvents() has nothing to do: no event to handle, and no timeout
+  // due.
+  static bool idle();
   static void FlushEvents() {
     queue_.Flush();
+    uint8_t sreg = SREG;
+    cli();
+    pending_pots_ = 0;
+    SREG = sreg;
   }
   static uint8_t led_pattern() {
     return led_pattern_;
@@ -93,11 +102,14 @@ class Ui {
   static void TrySavingSettings();
   static void HandleSwitchEvent(uint8_t index);
   static void HandlePotEvent(uint8_t index, uint8_t value);
+  static void ScanPots();
   static void UnlockPot(uint8_t index);
   static void LockPots(bool snap);
   
   static uint16_t adc_values_[kNumPots];
   static uint8_t adc_thresholds_[kNumPots];
+  static uint8_t adc_noise_[kNumPots];
+  static uint8_t adc_last_reading_[kNumPots];
   static bool snapped_[kNumPots];
   static int16_t snap_position_cache_[kNumPots];
   static uint8_t active_row_;
@@ -106,10 +118,19 @@ class Ui {
   static uint8_t inhibit_switch_;
   static uint8_t display_mode_;
   static uint8_t scanned_pot_;
+  static uint8_t swept_pot_;
+  static uint8_t active_pot_;
+  static uint8_t active_pot_idle_time_;
+  static uint16_t active_pot_average_;
   static uint8_t pot_scanning_warm_up_;
   static bool busy_;
   static int8_t display_snap_delta_;
   static avrlib::EventQueue<16> queue_;
+  
+  // Pot events are not queued: each pot has a slot holding the latest value
+  // it has taken since the last call to DoEvents(), and a pending bit.
+  static uint8_t pending_pot_value_[kNumPots];
+  static volatile uint16_t pending_pots_;
   static uint8_t disable_switch_sensing_;
   static uint16_t long_press_counter_;
   static bool strummer_enabled_;
@@ -72,6 +72,7 @@ void Voice::Init() {
   pitch_ = 0;
   locked_ = false;
   dirty_ = false;
+  modulation_dirty_ = true;
   retriggered_ = false;
   volume_ = 240;
 
@@ -94,6 +95,7 @@ void Voice::ControlChange(uint8_t controller, uint8_t value) {
       break;
     
   }
+  modulation_dirty_ = true;
 }
 
 void Voice::SetValue(uint8_t offset, uint8_t value) {
@@ -106,6 +108,7 @@ void Voice::SetValue(uint8_t offset, uint8_t value) {
   }
   if (previous_value != value) {
     dirty_ = true;
+    modulation_dirty_ = true;
   }
 }
 
@@ -142,6 +145,7 @@ void Voice::UpdateEnvelopeParameters() {
 
 void Voice::PitchBend(uint16_t pitch_bend) {
   mod_pitch_bend_ = pitch_bend;
+  modulation_dirty_ = true;
 }
 
 void Voice::Aftertouch(uint8_t velocity) {
@@ -159,24 +163,28 @@ void Voice::ResetAllControllers() {
   mod_wheel_ = 0;
   mod_wheel_2_ = 0;
   mod_aftertoutch_ = 0;
+  modulation_dirty_ = true;
 }
 
 void Voice::Refresh() {
+  if (modulation_dirty_) {
+    UpdateModulationParameters();
+  }
   while (writable()) {
     WriteDACStateSample();
   }
 }
 
-void Voice::WriteDACStateSample() {
-  uint8_t w = dac_state_write_ptr_;
-      
+void Voice::UpdateModulationParameters() {
   lfo_.set_shape(static_cast<LfoShape>(patch_.lfo_shape));
   if (patch_.lfo_rate >= 2) {
     lfo_.set_phase_increment(
-        pgm_read_dword(lut_res_lfo_increments + patch_.lfo_rate));
+        ReadExponentTable(lut_res_lfo_increments, patch_.lfo_rate));
   }
   vibrato_lfo_.set_phase_increment(
-      pgm_read_dword(lut_res_lfo_increments + 96 + (patch_.vibrato_rate >> 1)));
+      ReadExponentTable(
+          lut_res_lfo_increments,
+          96 + (patch_.vibrato_rate >> 1)));
 
   uint8_t mod_wheel_pitch = 0;
   uint8_t mod_wheel_growl = 0;
@@ -189,14 +197,59 @@ void Voice::WriteDACStateSample() {
     mod_wheel_growl = mod_wheel_;
     mod_wheel_pitch = U8U8MulShift8(vibrato_destination << 1, mod_wheel_);
   }
+  mod_wheel_pitch_ = mod_wheel_pitch;
   
+  int16_t pitch = (mod_pitch_bend_ - 8192) >> 5;
+  pitch += S8U8Mul(patch_.vco_dco_range, 6) << 8;
+  pitch += patch_.vco_dco_fine;
+  dco_pitch_offset_ = pitch;
+  
+  pitch = S8U8Mul(patch_.vco_detune, 128);
+  pitch += patch_.vco_fine;
+  vco_pitch_offset_ = pitch;
+  
+  int16_t cutoff = 60 * 128;
+  cutoff += S8U8Mul(patch_.cutoff_bias + 128, 64);
+  cutoff_offset_ = cutoff;
+  
+  uint16_t growl_amount = mod_wheel_growl;
+  growl_amount += mod_wheel_2_;
+  // if (mod_aftertoutch_ > 112) {
+  //   growl_amount += (mod_aftertoutch_ - 112) << 2;
+  // }
+  if (growl_amount >= 255) {
+    growl_amount = 255;
+  }
+  growl_amount_ = growl_amount;
+  
+  uint16_t env_amount = patch_.cutoff_env_amount + (mod_accent_ >> 1);
+  env_amount += U8U8MulShift8(mod_velocity_, patch_.kbd_velocity_vcf_amount);
+  if (env_amount > 255) {
+    env_amount = 255;
+  }
+  vcf_env_amount_ = env_amount;
+  
+  vca_velocity_amount_ = U8Mix(
+      255,
+      mod_velocity_ << 1,
+      patch_.kbd_velocity_vca_amount);
+  
+  modulation_dirty_ = false;
+}
 
+void Voice::WriteDACStateSample() {
+  uint8_t w = dac_state_write_ptr_;
+  
   // Compute modulation sources.
   uint16_t lfo_unsigned = lfo_.Render();
   int16_t lfo = lfo_unsigned - 32768;
   int16_t vibrato_lfo = vibrato_lfo_.Render() - 32768;
   lfo_8_bits_ = lfo_unsigned >> 8;
-  uint16_t mod_envelope = mod_envelope_.Render();
+  // The modulation envelope shares its attack and decay times with the VCF
+  // envelope, and thus whole segments of it can be copied from the VCF
+  // envelope rather than computed again.
+  uint16_t vcf_envelope = vcf_envelope_.Render();
+  uint16_t mod_envelope = mod_envelope_.Render(vcf_envelope_);
 
   // VCO CV.
   pitch_counter_ += pitch_increment_;
@@ -206,25 +259,28 @@ void Voice::WriteDACStateSample() {
   }
   int16_t pitch = Mix(pitch_source_, pitch_target_, pitch_counter_);
   pitch_ = pitch;
-  pitch += (mod_pitch_bend_ - 8192) >> 5;
-  pitch += S8U8Mul(patch_.vco_dco_range, 6) << 8;
-  pitch += patch_.vco_dco_fine;
-  pitch += S8U8MulShift8(vibrato_lfo >> 8, mod_wheel_pitch);
+  pitch += dco_pitch_offset_;
+  pitch += S8U8MulShift8(vibrato_lfo >> 8, mod_wheel_pitch_);
   dco_pitch_ = pitch;
+  dac_state_buffer_[w].dco_period = DcoPeriod(pitch);
   
-  pitch += S8U8Mul(patch_.vco_detune, 128);
-  pitch += patch_.vco_fine;
+  pitch += vco_pitch_offset_;
   pitch += U16U8MulShift8(mod_envelope, patch_.vco_env_amount) >> 4;
   pitch += S16U8MulShift8(lfo, patch_.vco_lfo_amount) >> 4;
 
-  if (pitch < 60 * 128) {
-    pitch = static_cast<int32_t>(pitch - system_settings.vco_cv_offset()) * \
-        system_settings.vco_cv_scale_low() >> 16;
-  } else {
-    pitch = static_cast<int32_t>(pitch - system_settings.vco_cv_offset()) * \
-        system_settings.vco_cv_scale_high() >> 16;
+  // Piecewise linear VCO response measured by the tuner.
+  if (pitch < 0) {
+    pitch = 0;
+  } else if (pitch > 16383) {
+    pitch = 16383;
   }
-  pitch += 2048;
+  const int16_t* calibration = system_settings.vco_cv_calibration() + \
+      (pitch >> kVcoCvCalibrationShift);
+  int16_t cv_low = calibration[0];
+  int16_t cv_high = calibration[1];
+  pitch = cv_low + U16U8MulShift8(
+      cv_high - cv_low,
+      static_cast<uint8_t>(pitch >> (kVcoCvCalibrationShift - 8)));
   CLIP_12(pitch);
   dac_state_buffer_[w].vco_cv = pitch;
   
@@ -237,25 +293,10 @@ void Voice::WriteDACStateSample() {
   dac_state_buffer_[w].pw_cv = pw;
   
   // VCF CV.
-  uint16_t vcf_envelope = vcf_envelope_.Render();
-  int16_t cutoff = 60 * 128;
+  int16_t cutoff = cutoff_offset_;
   cutoff += S16U8MulShift8(dco_pitch_ - 60 * 128, patch_.cutoff_tracking) << 1;
-  cutoff += S8U8Mul(patch_.cutoff_bias + 128, 64);
-  uint16_t growl_amount = mod_wheel_growl;
-  growl_amount += mod_wheel_2_;
-  // if (mod_aftertoutch_ > 112) {
-  //   growl_amount += (mod_aftertoutch_ - 112) << 2;
-  // }
-  if (growl_amount >= 255) {
-    growl_amount = 255;
-  }
-  cutoff += S16U8MulShift8(vibrato_lfo, growl_amount) >> 3;
-  uint16_t env_amount = patch_.cutoff_env_amount + (mod_accent_ >> 1);
-  env_amount += U8U8MulShift8(mod_velocity_, patch_.kbd_velocity_vcf_amount);
-  if (env_amount > 255) {
-    env_amount = 255;
-  }
-  cutoff += U16U8MulShift8(vcf_envelope, env_amount) >> 2;
+  cutoff += S16U8MulShift8(vibrato_lfo, growl_amount_) >> 3;
+  cutoff += U16U8MulShift8(vcf_envelope, vcf_env_amount_) >> 2;
   cutoff += S16U8MulShift8(lfo, patch_.cutoff_lfo_amount) >> 3;
   // cutoff += U8U8Mul(mod_aftertoutch_, 64);
   cutoff = static_cast<int32_t>(cutoff - kVcfCvOffset) * kVcfCvScale >> 16;
@@ -266,16 +307,45 @@ void Voice::WriteDACStateSample() {
   // VCA CV.
   uint16_t vca_envelope = U16U8MulShift8(
       vca_envelope_.Render(),
-      U8Mix(255, mod_velocity_ << 1, patch_.kbd_velocity_vca_amount));
+      vca_velocity_amount_);
   vca_envelope = U16U8MulShift8(vca_envelope, volume_);
   dac_state_buffer_[w].vca_cv = U16ShiftRight4(vca_envelope);
+  // Make sure the new state is entirely written before publishing it.
+  __asm__ __volatile__("" ::: "memory");
   dac_state_write_ptr_ = (w + 1) & (kDACStateBufferSize - 1);
 }
 
+static const uint16_t kOctave = 12 << 7;
+static const uint16_t kFirstNote = 16 << 7;
+
+/* static */
+uint16_t Voice::DcoPeriod(int16_t pitch) {
+  // Lowest note: E0. The notes of the 3 octaves below are transposed up to the
+  // lowest octave.
+  int16_t note = pitch - kFirstNote + 3 * kOctave;
+  if (note < 0) {
+    note = 0;
+  }
+  // Octave and note within the octave, without division: x * 171 >> 11 is
+  // equal to x / 12 for all 8-bit values of x.
+  uint8_t octave = static_cast<uint16_t>(note >> 7) * 171 >> 11;
+  note -= U8U8Mul(octave, 12) << 7;
+  uint16_t index_integral = U16ShiftRight4(note);
+  uint16_t index_fractional = U8U8Mul(note & 0xf, 16);
+  uint16_t count = pgm_read_word(lut_res_dco_pitch + index_integral);
+  uint16_t next = pgm_read_word(lut_res_dco_pitch + index_integral + 1);
+  count -= U16U8MulShift8(count - next, index_fractional);
+  if (octave > 3) {
+    count >>= octave - 3;
+  }
+  return count;
+}
+
 void Voice::GateOn() {
   vca_envelope_.Trigger(ENV_SEGMENT_ATTACK);
   vcf_envelope_.Trigger(ENV_SEGMENT_ATTACK);
   mod_envelope_.Trigger(ENV_SEGMENT_ATTACK);
+  mod_envelope_.Link(vcf_envelope_);
   if (gate()) {
     retriggered_ = true;
   }
@@ -285,6 +355,7 @@ void Voice::GateOff() {
   vca_envelope_.Trigger(ENV_SEGMENT_RELEASE);
   vcf_envelope_.Trigger(ENV_SEGMENT_RELEASE);
   mod_envelope_.Trigger(ENV_SEGMENT_RELEASE);
+  mod_envelope_.Link(vcf_envelope_);
 }
 
 void Voice::NoteOn(
@@ -304,6 +375,7 @@ void Voice::NoteOn(
   }
   mod_velocity_ = velocity;
   mod_accent_ = accent;
+  modulation_dirty_ = true;
   
   // When legato mode is enabled, and when the notes are not played legato,
   // There is no glide applied.
@@ -333,6 +405,7 @@ void Voice::SavePatch() {
 
 void Voice::ResetToFactoryDefaults() {
   storage.ResetToFactoryDefaults(&patch_);
+  modulation_dirty_ = true;
 }
 
 };  // namespace anu
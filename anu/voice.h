@@ -63,7 +63,14 @@ enum PatchParameter {
   PRM_PATCH_LAST
 };
 
-static const uint8_t kDACStateBufferSize = 4;
+// Depth of the DAC state buffer. Must be a power of 2, 128 at most.
+// The DACs are refreshed at 2.45kHz, so each entry buffers 0.4ms of main
+// loop stall - but also delays the response to controller changes by as much.
+#ifndef DAC_STATE_BUFFER_SIZE
+#define DAC_STATE_BUFFER_SIZE 4
+#endif  // DAC_STATE_BUFFER_SIZE
+
+static const uint8_t kDACStateBufferSize = DAC_STATE_BUFFER_SIZE;
 
 struct Patch {
   int8_t vco_dco_range;
@@ -105,6 +112,8 @@ struct DACState {
   uint16_t pw_cv;
   uint16_t vcf_cv;
   uint16_t vca_cv;
+  // Timer1 TOP value producing the DCO square wave.
+  uint16_t dco_period;
 };
 
 class Voice {
@@ -168,9 +177,13 @@ class Voice {
     locked_ = true;
   }
   
+  // The DAC state buffer has a single producer (WriteDACStateSample, from the
+  // main loop) and a single consumer (ReadDACStateSample, from the DAC ISR).
+  // Each side owns one 8-bit pointer, so no locking is needed. When the
+  // buffer is empty, the previous state is held.
   void ReadDACStateSample() {
-    if (!locked_) {
-      uint8_t r = dac_state_read_ptr_;
+    uint8_t r = dac_state_read_ptr_;
+    if (!locked_ && r != dac_state_write_ptr_) {
       dac_state_ = dac_state_buffer_[r];
       dac_state_read_ptr_ = (r + 1) & (kDACStateBufferSize - 1);
     }
@@ -196,11 +209,14 @@ class Voice {
   
   void Touch() {
     UpdateEnvelopeParameters();
+    modulation_dirty_ = true;
   }
   
  private:
   void WriteDACStateSample();
+  static uint16_t DcoPeriod(int16_t pitch);
   void UpdateEnvelopeParameters();
+  void UpdateModulationParameters();
    
   Patch patch_;
   Lfo lfo_;
@@ -211,6 +227,7 @@ class Voice {
   
   bool locked_;
   bool dirty_;
+  bool modulation_dirty_;
   bool retriggered_;
   
   uint8_t lfo_8_bits_;
@@ -221,10 +238,6 @@ class Voice {
   uint16_t vca_cv_;
   int16_t dco_pitch_;
   
-  int16_t vco_cv_offset_;
-  uint16_t vco_cv_scale_low_;
-  uint16_t vco_cv_scale_high_;
-
   uint16_t pitch_counter_;
   uint16_t pitch_increment_;
   int16_t pitch_source_;
@@ -239,10 +252,20 @@ class Voice {
   uint8_t mod_accent_;
   uint8_t volume_;
   
+  // Control-rate modulation coefficients, derived from the patch and the
+  // controllers by UpdateModulationParameters() whenever they change.
+  int16_t dco_pitch_offset_;
+  int16_t vco_pitch_offset_;
+  int16_t cutoff_offset_;
+  uint8_t mod_wheel_pitch_;
+  uint8_t growl_amount_;
+  uint8_t vcf_env_amount_;
+  uint8_t vca_velocity_amount_;
+  
   DACState dac_state_;
   DACState dac_state_buffer_[kDACStateBufferSize];
-  uint8_t dac_state_read_ptr_;
-  uint8_t dac_state_write_ptr_;
+  volatile uint8_t dac_state_read_ptr_;
+  volatile uint8_t dac_state_write_ptr_;
   
   DISALLOW_COPY_AND_ASSIGN(Voice);
 };
@@ -15,6 +15,7 @@
 
 #include "anu/voice_controller.h"
 
+#include <avr/eeprom.h>
 #include <avr/pgmspace.h>
 
 #include "avrlib/op.h"
@@ -36,7 +37,7 @@ Sequence VoiceController::sequence_;
 Voice VoiceController::voice_;
 
 bool VoiceController::ignore_note_off_messages_;
-uint8_t VoiceController::clock_pulse_;
+volatile uint8_t VoiceController::clock_pulse_;
 uint8_t VoiceController::clock_counter_;
 
 NoteStack<16> VoiceController::pressed_keys_;
@@ -53,14 +54,26 @@ uint16_t VoiceController::arp_pattern_mask_;
 uint8_t VoiceController::arp_pattern_step_;
 int8_t VoiceController::arp_direction_;
 int8_t VoiceController::arp_step_;
-int8_t VoiceController::arp_octave_;
+uint8_t VoiceController::arp_notes_[kMaxArpeggiatorSteps];
+uint8_t VoiceController::arp_velocities_[kMaxArpeggiatorSteps];
+uint8_t VoiceController::arp_num_steps_;
+uint16_t VoiceController::arp_pattern_;
 uint8_t VoiceController::lfo_sync_counter_;
 
 uint8_t VoiceController::drum_sequencer_step_;
 uint8_t VoiceController::drum_sequencer_perturbation_[3];
+uint8_t VoiceController::drum_levels_[kNumDrumSteps][kNumDrumParts];
+uint8_t VoiceController::drum_levels_valid_[kNumDrumSteps / 8];
 uint8_t VoiceController::drum_remote_control_current_instrument_;
 
 bool VoiceController::dirty_;
+
+uint8_t VoiceController::pending_sequence_slot_ = kNumSequenceSlots;
+
+uint8_t VoiceController::encoder_num_notes_;
+uint8_t VoiceController::encoder_flags_;
+uint8_t VoiceController::encoder_step_;
+uint8_t VoiceController::encoder_bitfield_byte_;
 /* </static> */
 
 typedef SequencerSettings PROGMEM prog_SequencerSettings;
@@ -85,7 +98,7 @@ static const prog_SequencerSettings init_seq_settings PROGMEM = {
   // Acidity
   0,
   
-  // Padding
+  // Sequence slot and padding
   0, 0,
 };
 
@@ -112,16 +125,6 @@ struct StorageLayout<SequencerSettings> {
   }
 };
 
-template<>
-struct StorageLayout<Sequence> {
-  static uint8_t* eeprom_address() { 
-    return (uint8_t*)(256);
-  }
-  static const prog_char* init_data() {
-    return (prog_char*)&init_sequence;
-  }
-};
-
 //BER:NOTE: 4 ppqn no longer available after port of 32 step nodes from Grids
 uint8_t clock_divisions[] = { 2, 2, 6 };
 uint8_t clock_internal_rate_compensation[] = { 3, 3, 1 };
@@ -130,9 +133,17 @@ uint8_t clock_internal_rate_compensation[] = { 3, 3, 1 };
 void VoiceController::Init() {
   STATIC_ASSERT(sizeof(SequencerSettings) == PRM_SEQ_LAST);
   
+  // The sequence slots end where the system settings start.
+  STATIC_ASSERT(
+      kSequenceSlotsAddress + kNumSequenceSlots * kSequenceSlotSize <= 960);
+  
   storage.Load(&seq_settings_);
-  storage.Load(&sequence_);
+  if (seq_settings_.sequence_slot >= kNumSequenceSlots) {
+    seq_settings_.sequence_slot = 0;
+  }
+  LoadSequence();
   pressed_keys_.Init();
+  BuildArpeggiatorProgram();
   voice_.Init();
 
   ignore_note_off_messages_ = false;
@@ -147,6 +158,7 @@ void VoiceController::Init() {
 
   RefreshDrumSynthSettings();
   RefreshDrumSynthMixing();
+  InvalidateDrumMap();
 
   drum_remote_control_current_instrument_ = 0;
 }
@@ -167,7 +179,7 @@ void VoiceController::RefreshDrumSynthMixing() {
 /* static */
 void VoiceController::TouchClock() {
   clock.Update(
-      seq_settings_.tempo,
+      internal_clock() ? seq_settings_.tempo : 0,
       1,
       seq_settings_.swing >> 1,
       clock_internal_rate_compensation[system_settings.clock_ppqn()]);
@@ -184,8 +196,13 @@ void VoiceController::SetValue(uint8_t offset, uint8_t value) {
     if (offset == PRM_SEQ_ARP_MODE) {
       arp_direction_ = \
           seq_settings_.arp_direction() == ARPEGGIO_DIRECTION_DOWN ? -1 : 1;
+      BuildArpeggiatorProgram();
+    } else if (offset == PRM_SEQ_ARP_PATTERN) {
+      BuildArpeggiatorProgram();
     } else if (offset >= PRM_SEQ_TEMPO && offset <= PRM_SEQ_SWING) {
       TouchClock();
+    } else if (offset == PRM_SEQ_DRUMS_X || offset == PRM_SEQ_DRUMS_Y) {
+      InvalidateDrumMap();
     } else if (offset >= PRM_SEQ_DRUMS_BD_TONE && \
                offset <= PRM_SEQ_DRUMS_HH_TONE) {
       RefreshDrumSynthSettings();
@@ -212,6 +229,7 @@ void VoiceController::NoteOn(uint8_t note, uint8_t velocity) {
         // If the arpeggiator is off, actually trigger the note!
         voice_.NoteOn(note, velocity, 0, 0, pressed_keys_.size() != 1);
       } else {
+        BuildArpeggiatorProgram();
         if (pressed_keys_.size() == 1 && !clock_running_) {
           StartClock();
           StartArpeggiator();
@@ -223,6 +241,7 @@ void VoiceController::NoteOn(uint8_t note, uint8_t velocity) {
       if (sequence_.num_notes == 128) {
         sequencer_recording_ = false;
       }
+      TouchSequence();
     }
   }
 }
@@ -253,6 +272,7 @@ void VoiceController::NoteOff(uint8_t note) {
       }
     } else {
       pressed_keys_.NoteOff(note);
+      BuildArpeggiatorProgram();
       if (pressed_keys_.size() == 0) {
         StopArpeggiator();
         if (!sequencer_running_) {
@@ -279,6 +299,7 @@ void VoiceController::ControlChange(uint8_t controller, uint8_t value) {
     uint8_t accent_slide_index = sequence_.num_notes >> 3;
     uint8_t accent_slide_mask = 1 << (sequence_.num_notes & 0x7);
     sequence_.accents[accent_slide_index] |= accent_slide_mask;
+    TouchSequence();
   }
   voice_.ControlChange(controller, value);
   switch (controller) {
@@ -292,7 +313,7 @@ void VoiceController::ControlChange(uint8_t controller, uint8_t value) {
   }
   uint8_t parameter_number = parameter_manager.LookupCCMap(controller);
   if (parameter_number != 0xff) {
-    parameter_manager.SetScaled(parameter_number, value << 1);
+    parameter_manager.QueueScaled(parameter_number, value << 1);
   }
 }
 
@@ -304,6 +325,7 @@ void VoiceController::PitchBend(uint16_t pitch_bend) {
     uint8_t accent_slide_index = sequence_.num_notes >> 3;
     uint8_t accent_slide_mask = 1 << (sequence_.num_notes & 0x7);
     sequence_.slides[accent_slide_index] |= accent_slide_mask;
+    TouchSequence();
   }
 }
 
@@ -330,8 +352,7 @@ void VoiceController::AllNotesOff() {
 }
 
 /* static */
-void VoiceController::Clock(bool midi_generated) {
-  clock_pulse_ = 8;
+void VoiceController::Clock() {
   voice_.set_lfo_pll_target_phase(lfo_sync_counter_);
   if (!clock_counter_) {
     ClockArpeggiator();
@@ -342,7 +363,6 @@ void VoiceController::Clock(bool midi_generated) {
   if (clock_counter_ == (clock_divisions[system_settings.clock_ppqn()] >> 1)) {
     ClockDrumMachine(); // Twice the update rate since 32 step nodes ported from Grids
   }
-  midi_dispatcher.OnClock(midi_generated);
   ++clock_counter_;
   if (clock_counter_ >= clock_divisions[system_settings.clock_ppqn()]) {
     clock_counter_ = 0;
@@ -469,10 +489,19 @@ void VoiceController::ClockDrumMachine() {
   // BER:NOTE: pre-programmed patterns only have 16 steps (vs 32 step nodes ported from Grids)
   uint16_t program_step_mask = 1 << (drum_sequencer_step_ >> 1);
   if (has_drums()) {
-    uint8_t x = seq_settings_.drums_x;
-    uint8_t y = seq_settings_.drums_y;
+    uint8_t* levels = drum_levels_[drum_sequencer_step_];
+    uint8_t valid_index = drum_sequencer_step_ >> 3;
+    uint8_t valid_mask = 1 << (drum_sequencer_step_ & 7);
+    if (!(drum_levels_valid_[valid_index] & valid_mask)) {
+      uint8_t x = seq_settings_.drums_x;
+      uint8_t y = seq_settings_.drums_y;
+      for (uint8_t i = 0; i < kNumDrumParts; ++i) {
+        levels[i] = ReadDrumMap(drum_sequencer_step_, i, x, y);
+      }
+      drum_levels_valid_[valid_index] |= valid_mask;
+    }
     for (uint8_t i = 0; i < kNumDrumParts; ++i) {
-      uint8_t level = ReadDrumMap(drum_sequencer_step_, i, x, y);
+      uint8_t level = levels[i];
       if (level < 255 - drum_sequencer_perturbation_[i]) {
         level += drum_sequencer_perturbation_[i];
       }
@@ -497,7 +526,7 @@ void VoiceController::ClockDrumMachine() {
     }
   }
   ++drum_sequencer_step_;
-  if (drum_sequencer_step_ >= 32) { // BER:NOTE: 32 step in drum nodes ported from Grids
+  if (drum_sequencer_step_ >= kNumDrumSteps) { // BER:NOTE: 32 step in drum nodes ported from Grids
     drum_sequencer_step_ = 0;
     for (uint8_t i = 0; i < kNumDrumParts; ++i) {
       drum_sequencer_perturbation_[i] = Random::GetByte() >> 3;
@@ -516,26 +545,21 @@ const prog_uint8_t accent_level[] PROGMEM = {
 /* static */
 void VoiceController::ClockArpeggiator() {
   if (has_arpeggiator()) {
-    uint16_t pattern = pgm_read_word(
-        lut_res_arpeggiator_patterns + seq_settings_.arp_pattern);
-    uint8_t has_arpeggiator_note = (arp_pattern_mask_ & pattern) ? 255 : 0;
+    uint8_t has_arpeggiator_note = \
+        (arp_pattern_mask_ & arp_pattern_) ? 255 : 0;
 
     // Trigger notes only if the arp is on, and if keys are pressed.
     if (has_arpeggiator_note) {
       StepArpeggiator();
-      const NoteEntry& arpeggio_note = pressed_keys_.sorted_note(arp_step_);
-      uint8_t note = arpeggio_note.note;
-      uint8_t velocity = arpeggio_note.velocity;
-      note += 12 * arp_octave_;
-      while (note > 127) {
-        note -= 12;
-      }
+      uint8_t note = arp_notes_[arp_step_];
+      uint8_t velocity = arp_velocities_[arp_step_];
       uint8_t random = Random::GetByte();
       uint8_t slide_threshold = U8U8Mul(
           pgm_read_byte(slide_probability + arp_pattern_step_),
           seq_settings_.acidity);
       // Slide less frequently to first note.
-      if (arp_step_ == 0) {
+      if (note & kArpeggiatorLowestKey) {
+        note &= ~kArpeggiatorLowestKey;
         slide_threshold >>= 1;
       }
       uint8_t accent = U8U8Mul(
@@ -567,52 +591,51 @@ void VoiceController::ClockArpeggiator() {
 }
 
 /* static */
-void VoiceController::ResetArpeggiatorPattern() {
-  if (arp_direction_ == 1) {
-    arp_octave_ = 0;
-    arp_step_ = 0;
-  } else {
-    arp_step_ = pressed_keys_.size() - 1;
-    arp_octave_ = seq_settings_.arp_range() - 1;
+void VoiceController::BuildArpeggiatorProgram() {
+  arp_pattern_ = pgm_read_word(
+      lut_res_arpeggiator_patterns + seq_settings_.arp_pattern);
+  uint8_t num_keys = pressed_keys_.size();
+  uint8_t num_octaves = seq_settings_.arp_mode ? seq_settings_.arp_range() : 0;
+  uint8_t n = 0;
+  for (uint8_t octave = 0; octave < num_octaves; ++octave) {
+    for (uint8_t i = 0; i < num_keys; ++i) {
+      const NoteEntry& key = pressed_keys_.sorted_note(i);
+      uint8_t note = key.note + 12 * octave;
+      while (note > 127) {
+        note -= 12;
+      }
+      arp_notes_[n] = i == 0 ? note | kArpeggiatorLowestKey : note;
+      arp_velocities_[n] = key.velocity;
+      ++n;
+    }
   }
+  arp_num_steps_ = n;
+  // Keep the current position when keys are added or removed.
+  if (arp_step_ >= n) {
+    arp_step_ = n ? n - 1 : 0;
+  }
+}
+
+/* static */
+void VoiceController::ResetArpeggiatorPattern() {
+  arp_step_ = arp_direction_ == 1 ? 0 : arp_num_steps_ - 1;
 }
 
 /* static */
 void VoiceController::StepArpeggiator() {
-  uint8_t num_notes = pressed_keys_.size();
   if (seq_settings_.arp_direction() == ARPEGGIO_DIRECTION_RANDOM) {
-    uint8_t random_byte = Random::GetByte();
-    arp_octave_ = random_byte & 0xf;
-    arp_step_ = (random_byte & 0xf0) >> 4;
-    while (arp_octave_ >= seq_settings_.arp_range()) {
-      arp_octave_ -= seq_settings_.arp_range();
-    }
-    while (arp_step_ >= num_notes) {
-      arp_step_ -= num_notes;
-    }
-  } else {
-    arp_step_ += arp_direction_;
-    uint8_t change_octave = 0;
-    if (arp_step_ >= num_notes) {
-      arp_step_ = 0;
-      change_octave = 1;
-    } else if (arp_step_ < 0) {
-      arp_step_ = num_notes - 1;
-      change_octave = 1;
-    }
-    if (change_octave) {
-      arp_octave_ += arp_direction_;
-      if (arp_octave_ >= seq_settings_.arp_range() || arp_octave_ < 0) {
-        if (seq_settings_.arp_direction() == ARPEGGIO_DIRECTION_UP_DOWN) {
-          arp_direction_ = -arp_direction_;
-          ResetArpeggiatorPattern();
-          if (num_notes > 1 || seq_settings_.arp_range() > 1) {
-            StepArpeggiator();
-          }
-        } else {
-          ResetArpeggiatorPattern();
-        }
-      }
+    arp_step_ = U8U8MulShift8(Random::GetByte(), arp_num_steps_);
+    return;
+  }
+  arp_step_ += arp_direction_;
+  if (arp_step_ >= arp_num_steps_ || arp_step_ < 0) {
+    if (seq_settings_.arp_direction() == ARPEGGIO_DIRECTION_UP_DOWN &&
+        arp_num_steps_ > 1) {
+      // Bounce without repeating the highest or lowest note.
+      arp_direction_ = -arp_direction_;
+      arp_step_ += 2 * arp_direction_;
+    } else {
+      ResetArpeggiatorPattern();
     }
   }
 }
@@ -623,7 +646,10 @@ void VoiceController::StartRecording() {
   StopArpeggiator();
   seq_settings_.arp_mode = 0;
   sequencer_recording_ = true;
+  // The recording replaces the sequence of the current slot.
+  pending_sequence_slot_ = kNumSequenceSlots;
   memset(&sequence_, 0, sizeof(Sequence));
+  TouchSequence();
 }
 
 /* static */
@@ -637,7 +663,143 @@ void VoiceController::StopRecording() {
 
 /* static */
 void VoiceController::SaveSequence() {
-  storage.Save(sequence_);
+  storage.Save(
+      &ReadEncodedSequence,
+      sequence_slot_address(seq_settings_.sequence_slot),
+      kSequenceSlotSize - 1);
+}
+
+/* static */
+void VoiceController::TouchSequence() {
+  // The save in progress has encoded part of the previous sequence. Restart it
+  // from the first byte, so that the slot is not committed with a mix of the
+  // previous and new sequences.
+  uint8_t* address = sequence_slot_address(seq_settings_.sequence_slot);
+  if (storage.pending(address)) {
+    SaveSequence();
+  }
+}
+
+/* static */
+bool VoiceController::CancelSaveSequence() {
+  return storage.Cancel(sequence_slot_address(seq_settings_.sequence_slot));
+}
+
+/* static */
+uint8_t VoiceController::ReadEncodedSequence(uint16_t offset) {
+  if (offset == 0) {
+    encoder_num_notes_ = sequence_.num_notes;
+    if (encoder_num_notes_ > 128) {
+      encoder_num_notes_ = 128;
+    }
+    encoder_flags_ = 0;
+    for (uint8_t i = 0; i < 16; ++i) {
+      if (sequence_.accents[i]) {
+        encoder_flags_ |= kSequenceFlagAccents;
+      }
+      if (sequence_.slides[i]) {
+        encoder_flags_ |= kSequenceFlagSlides;
+      }
+    }
+    encoder_step_ = 0;
+    encoder_bitfield_byte_ = 0;
+    return encoder_num_notes_;
+  } else if (offset == 1) {
+    return encoder_flags_;
+  }
+  
+  if (encoder_step_ < encoder_num_notes_) {
+    uint8_t note = sequence_.notes[encoder_step_++];
+    if (note != 0xff && note != 0xfe) {
+      return note & 0x7f;
+    }
+    // Rests and ties are grouped in runs of up to 32 steps.
+    uint8_t run = 1;
+    while (encoder_step_ < encoder_num_notes_ &&
+           run < kSequenceCodeMaxRun &&
+           sequence_.notes[encoder_step_] == note) {
+      ++encoder_step_;
+      ++run;
+    }
+    return (note == 0xff ? kSequenceCodeRest : kSequenceCodeTie) | (run - 1);
+  }
+  
+  while (encoder_bitfield_byte_ < 32) {
+    uint8_t i = encoder_bitfield_byte_++;
+    if (i < 16) {
+      if (encoder_flags_ & kSequenceFlagAccents) {
+        return sequence_.accents[i];
+      }
+    } else if (encoder_flags_ & kSequenceFlagSlides) {
+      return sequence_.slides[i - 16];
+    }
+  }
+  return 0;
+}
+
+/* static */
+bool VoiceController::DecodeSequence(const uint8_t* address) {
+  uint8_t checksum = 0;
+  for (uint8_t i = 0; i < kSequenceSlotSize - 1; ++i) {
+    checksum += eeprom_read_byte(address + i);
+  }
+  if (checksum != eeprom_read_byte(address + kSequenceSlotSize - 1)) {
+    return false;
+  }
+  
+  uint8_t num_notes = eeprom_read_byte(address++);
+  uint8_t flags = eeprom_read_byte(address++);
+  if (num_notes > 128) {
+    return false;
+  }
+  memset(&sequence_, 0, sizeof(Sequence));
+  uint8_t step = 0;
+  while (step < num_notes) {
+    uint8_t code = eeprom_read_byte(address++);
+    if (code < kSequenceCodeRest) {
+      sequence_.notes[step++] = code;
+      continue;
+    }
+    uint8_t run = (code & (kSequenceCodeMaxRun - 1)) + 1;
+    if (code >= kSequenceCodeTie + kSequenceCodeMaxRun ||
+        run > num_notes - step) {
+      return false;
+    }
+    uint8_t value = code < kSequenceCodeTie ? 0xff : 0xfe;
+    while (run--) {
+      sequence_.notes[step++] = value;
+    }
+  }
+  if (flags & kSequenceFlagAccents) {
+    eeprom_read_block(sequence_.accents, address, 16);
+    address += 16;
+  }
+  if (flags & kSequenceFlagSlides) {
+    eeprom_read_block(sequence_.slides, address, 16);
+  }
+  sequence_.num_notes = num_notes;
+  return true;
+}
+
+/* static */
+bool VoiceController::ImportLegacySequence() {
+  // The raw sequence and its checksum fit in slot 0, so this only succeeds
+  // until slot 0 has been written once.
+  STATIC_ASSERT(sizeof(Sequence) < kSequenceSlotSize);
+  const uint8_t* address = sequence_slot_address(0);
+  eeprom_read_block(&sequence_, address, sizeof(Sequence));
+  uint8_t checksum = 0;
+  const uint8_t* data = static_cast<const uint8_t*>(
+      static_cast<const void*>(&sequence_));
+  for (uint8_t i = 0; i < sizeof(Sequence); ++i) {
+    checksum += data[i];
+  }
+  if (checksum != eeprom_read_byte(address + sizeof(Sequence)) ||
+      sequence_.num_notes > 128) {
+    return false;
+  }
+  SaveSequence();
+  return true;
 }
 
 /* static */
@@ -649,10 +811,65 @@ void VoiceController::SavePatch() {
   dirty_ = false;
 }
 
+/* static */
+void VoiceController::LoadSequence() {
+  // A slot switch which is still pending replaces the sequence anyway.
+  if (pending_sequence_slot_ == kNumSequenceSlots) {
+    pending_sequence_slot_ = seq_settings_.sequence_slot;
+  }
+  RefreshSequence();
+}
+
+/* static */
+void VoiceController::SelectSequence(uint8_t slot) {
+  if (slot >= kNumSequenceSlots || sequencer_recording_) {
+    return;
+  }
+  pending_sequence_slot_ = slot;
+  RefreshSequence();
+}
+
+/* static */
+void VoiceController::RefreshSequence() {
+  if (pending_sequence_slot_ == kNumSequenceSlots) {
+    return;
+  }
+  // A pending save of the current slot still reads the sequence in RAM, and
+  // decoding the target slot while it is being written would read it half
+  // written. The saves of the other objects do not matter.
+  if (storage.pending(sequence_slot_address(seq_settings_.sequence_slot)) ||
+      storage.pending(sequence_slot_address(pending_sequence_slot_))) {
+    return;
+  }
+  if (pending_sequence_slot_ != seq_settings_.sequence_slot) {
+    seq_settings_.sequence_slot = pending_sequence_slot_;
+    dirty_ = true;
+  }
+  pending_sequence_slot_ = kNumSequenceSlots;
+  if (!DecodeSequence(sequence_slot_address(seq_settings_.sequence_slot)) &&
+      !(seq_settings_.sequence_slot == 0 && ImportLegacySequence())) {
+    memcpy_P(&sequence_, &init_sequence, sizeof(Sequence));
+  }
+  // Keep playing from the same position, so that switching happens in time.
+  if (sequencer_note_ >= sequence_.num_notes) {
+    sequencer_note_ = 0;
+  }
+}
+
 /* static */
 void VoiceController::ResetToFactoryDefaults() {
+  parameter_manager.DiscardQueuedValues();
   storage.ResetToFactoryDefaults(&seq_settings_);
-  storage.ResetToFactoryDefaults(&sequence_);
+  memcpy_P(&sequence_, &init_sequence, sizeof(Sequence));
+  for (uint8_t i = 0; i < kNumSequenceSlots; ++i) {
+    storage.Save(
+        &ReadEncodedSequence,
+        sequence_slot_address(i),
+        kSequenceSlotSize - 1);
+  }
+  // Only the save of the current slot is restarted when the sequence is
+  // edited. This runs at boot time, when waiting for the others is fine.
+  storage.Flush();
   voice_.ResetToFactoryDefaults();
 }
 
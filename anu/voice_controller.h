@@ -16,6 +16,8 @@
 #ifndef ANU_VOICE_CONTROLLER_H_
 #define ANU_VOICE_CONTROLLER_H_
 
+#include <avr/interrupt.h>
+
 #include "avrlib/base.h"
 #include "avrlib/random.h"
 
@@ -27,6 +29,12 @@
 namespace anu {
 
 static const uint8_t kNumDrumParts = 3;
+static const uint8_t kNumDrumSteps = 32;
+
+// Up to 16 held keys over 2 octaves.
+static const uint8_t kMaxArpeggiatorSteps = 32;
+// Set on the steps of the arpeggiator program playing the lowest held key.
+static const uint8_t kArpeggiatorLowestKey = 0x80;
 
 enum ArpeggiatorDirection {
   ARPEGGIO_DIRECTION_UP = 0,
@@ -59,8 +67,8 @@ enum SequencerSettingsParameter {
   PRM_SEQ_DRUMS_HH_PATTERN_L,
   PRM_SEQ_DRUMS_HH_PATTERN_H,
   PRM_SEQ_ARP_ACIDITY,
-  PRM_SEQ_PADDING_1,
-  PRM_SEQ_PADDING_2,
+  PRM_SEQ_SEQUENCE_SLOT,
+  PRM_SEQ_PADDING,
   PRM_SEQ_LAST
 };
 
@@ -81,7 +89,8 @@ struct SequencerSettings {
   uint16_t drums_pattern[kNumDrumParts];
   
   uint8_t acidity;
-  uint8_t padding[2];
+  uint8_t sequence_slot;
+  uint8_t padding;
   
   inline uint8_t arp_range() const { return ((arp_mode - 1) & 0x01) + 1; }
   inline uint8_t arp_direction() const { return (arp_mode - 1) >> 1; }
@@ -99,6 +108,27 @@ struct Sequence {
   uint8_t slides[16];
 };
 
+// Sequences are stored in EEPROM slots, in a compact encoding: the number of
+// notes, a flags byte, one code per note or per run of rests or ties, and the
+// accents and slides bitfields - omitted when empty. The sequence in RAM is a
+// copy of the selected slot, used for playback, recording and SysEx transfers.
+// It is encoded while it is being written, so each change to it restarts the
+// save in progress, and a slot is only loaded once the saves of the current
+// and target slots are complete. The sequence stays resident: the slots are
+// not streamed from the EEPROM during playback. Older firmware stored a single
+// raw sequence where slot 0 starts; it is converted the first time slot 0 is
+// found invalid.
+static const uint8_t kNumSequenceSlots = 4;
+static const uint16_t kSequenceSlotSize = 176;  // Including the checksum.
+static const uint16_t kSequenceSlotsAddress = 256;
+
+static const uint8_t kSequenceCodeRest = 0x80;
+static const uint8_t kSequenceCodeTie = 0xa0;
+static const uint8_t kSequenceCodeMaxRun = 32;
+
+static const uint8_t kSequenceFlagAccents = 1;
+static const uint8_t kSequenceFlagSlides = 2;
+
 class VoiceController {
  public:
   VoiceController() { }
@@ -112,7 +142,7 @@ class VoiceController {
   static void AllSoundOff();
   static void ResetAllControllers();
   static void AllNotesOff();
-  static void Clock(bool midi_generated);
+  static void Clock();
   
   static inline void Start() {
     StartClock();
@@ -151,6 +181,16 @@ class VoiceController {
   
   static void StopRecording();
   static void SaveSequence();
+  // The loading is deferred until no save of the current or target slot is
+  // pending, and completed by RefreshSequence(), which the main loop calls.
+  static void LoadSequence();
+  static void SelectSequence(uint8_t slot);
+  static void RefreshSequence();
+  // Called after each change to the sequence.
+  static void TouchSequence();
+  // Cancels the save of the current slot, if any, and returns whether there
+  // was one. Used before the sequence is overwritten in a single step.
+  static bool CancelSaveSequence();
   static void RemoteControlDrumSequencer(uint8_t note);
   static void StartRecording();
   
@@ -170,6 +210,7 @@ class VoiceController {
   static inline uint8_t clock_pulse() { return clock_pulse_; }
   static inline uint8_t sequencer_step() { return sequencer_note_; }
   static inline uint8_t sequence_length() { return sequence_.num_notes; }
+  static inline uint8_t sequence_slot() { return seq_settings_.sequence_slot; }
   static inline uint8_t internal_clock() { return seq_settings_.tempo >= 40; }
   static inline bool at_rest() {
     return pressed_keys_.size() == 0 && !sequencer_running_ && voice_.at_rest();
@@ -181,8 +222,17 @@ class VoiceController {
     return (seq_settings_.arp_mode && pressed_keys_.size());
   }
   
+  // Called from the DAC ISR, which the clock ISR can interrupt.
   static inline void ClearClockPulse() {
+    uint8_t sreg = SREG;
+    cli();
     --clock_pulse_;
+    SREG = sreg;
+  }
+  
+  // Called from the clock ISR at each clock pulse.
+  static inline void StartClockPulse() {
+    clock_pulse_ = 8;
   }
   
   static void SetValue(uint8_t address, uint8_t value);
@@ -197,14 +247,17 @@ class VoiceController {
   static void ReleaseAllHeldNotes();
   
   static void Touch() {
+    InvalidateDrumMap();
     RefreshDrumSynthSettings();
     RefreshDrumSynthMixing();
+    BuildArpeggiatorProgram();
     voice_.Touch();
   }
   static void TouchClock();
   
  private:
   static void ResetArpeggiatorPattern();
+  static void BuildArpeggiatorProgram();
 
   static void StartClock();
   static void StopClock();
@@ -228,13 +281,33 @@ class VoiceController {
       uint8_t instrument,
       uint8_t x,
       uint8_t y);
+  static inline void InvalidateDrumMap() {
+    for (uint8_t i = 0; i < sizeof(drum_levels_valid_); ++i) {
+      drum_levels_valid_[i] = 0;
+    }
+  }
+  
+  static uint8_t* sequence_slot_address(uint8_t slot) {
+    return (uint8_t*)(kSequenceSlotsAddress + slot * kSequenceSlotSize);
+  }
+  static uint8_t ReadEncodedSequence(uint16_t offset);
+  static bool DecodeSequence(const uint8_t* address);
+  static bool ImportLegacySequence();
   
   static SequencerSettings seq_settings_;
   static Sequence sequence_;
+  // Slot to load once the storage is idle, or kNumSequenceSlots.
+  static uint8_t pending_sequence_slot_;
+  
+  // Progress of the encoder of the sequence being written to EEPROM.
+  static uint8_t encoder_num_notes_;
+  static uint8_t encoder_flags_;
+  static uint8_t encoder_step_;
+  static uint8_t encoder_bitfield_byte_;
   static Voice voice_;
   
   static bool ignore_note_off_messages_;
-  static uint8_t clock_pulse_;
+  static volatile uint8_t clock_pulse_;
   static uint8_t clock_counter_;
   static uint8_t lfo_sync_counter_;
   
@@ -252,11 +325,25 @@ class VoiceController {
   static uint8_t arp_pattern_step_;
   static int8_t arp_direction_;
   static int8_t arp_step_;
-  static int8_t arp_octave_;
+  
+  // The notes played by the arpeggiator, from the lowest to the highest,
+  // across all octaves of its range. This program is rebuilt when the held
+  // keys or the arpeggiator settings change, so that the clock only has to
+  // move arp_step_ back and forth within it.
+  static uint8_t arp_notes_[kMaxArpeggiatorSteps];
+  static uint8_t arp_velocities_[kMaxArpeggiatorSteps];
+  static uint8_t arp_num_steps_;
+  static uint16_t arp_pattern_;
   
   static uint8_t drum_sequencer_step_;
   static uint8_t drum_sequencer_perturbation_[kNumDrumParts];
   
+  // Drum map levels interpolated for the current X/Y position. A step is
+  // interpolated the first time it is played, and then read from the cache
+  // until X or Y change.
+  static uint8_t drum_levels_[kNumDrumSteps][kNumDrumParts];
+  static uint8_t drum_levels_valid_[kNumDrumSteps / 8];
+  
   static uint8_t drum_remote_control_current_instrument_;
   
   static bool dirty_;
@@ -16,9 +16,10 @@
 #include "anu/voice_tuner.h"
 
 #include <avr/interrupt.h>
-#include <math.h>
 
 #include "anu/dco_controller.h"
+#include "anu/dsp_utils.h"
+#include "anu/resources.h"
 #include "anu/system_settings.h"
 #include "anu/voice_controller.h"
 
@@ -28,36 +29,45 @@ namespace anu {
 uint8_t VoiceTuner::tuning_state_;
 
 /* static */
-uint32_t VoiceTuner::pitch_measurements_;
+volatile uint32_t VoiceTuner::pitch_measurements_;
 
 /* static */
-uint8_t VoiceTuner::num_pitch_measurements_;
+volatile uint16_t VoiceTuner::num_pitch_measurements_;
 
 /* static */
-float VoiceTuner::pitch_c1_;
+volatile uint8_t VoiceTuner::num_discarded_periods_;
 
 /* static */
-float VoiceTuner::pitch_c3_;
+uint8_t VoiceTuner::point_;
 
 /* static */
-float VoiceTuner::pitch_c5_;
+uint8_t VoiceTuner::num_windows_;
+
+/* static */
+int32_t VoiceTuner::previous_window_pitch_;
+
+/* static */
+uint32_t VoiceTuner::previous_window_measurements_;
+
+/* static */
+uint16_t VoiceTuner::previous_window_num_measurements_;
+
+/* static */
+int32_t VoiceTuner::response_[kNumTuningPoints];
 
 /* static */
 TuningTimer VoiceTuner::tuning_timer_;
 
 /* static */
-void VoiceTuner::SetTuningState(uint8_t state) {
-  tuning_state_ = state;
+void VoiceTuner::StartProbe(uint8_t point) {
+  point_ = point;
+  num_windows_ = 0;
+  uint8_t sreg = SREG;
   cli();
+  num_discarded_periods_ = kTuningNumDiscardedPeriods;
   num_pitch_measurements_ = 0;
   pitch_measurements_ = 0;
-  sei();
-}
-
-/* static */
-float VoiceTuner::GetPitch() {
-  return static_cast<float>(num_pitch_measurements_ - 8) \
-      * (F_CPU / 8) / static_cast<float>(pitch_measurements_);
+  SREG = sreg;
 }
 
 /* static */
@@ -66,52 +76,122 @@ void VoiceTuner::StartTuning() {
   tuning_timer_.set_mode(0, 0, 2);
   tuning_timer_.Start();
   tuning_timer_.StartInputCapture();
-  SetTuningState(TUNING_PROBING_C1);
+  StartProbe(0);
+  tuning_state_ = TUNING_PROBING;
+}
+
+/* static */
+int32_t VoiceTuner::Log2(uint32_t x) {
+  // Returns the base 2 log of x, in 16:16 fixed point.
+  if (!x) {
+    return 0;
+  }
+  uint8_t exponent = 31;
+  while (!(x & 0x80000000)) {
+    x <<= 1;
+    --exponent;
+  }
+  uint16_t mantissa = x >> 15;
+  return (static_cast<int32_t>(exponent) << 16) + \
+      InterpolateIncreasing(lut_res_log2, mantissa);
+}
+
+/* static */
+int32_t VoiceTuner::MeasuredPitch(
+    uint32_t measurements,
+    uint16_t num_measurements) {
+  // The frequency is F_CPU / 8 / period, and the pitch, in 1/16th of pitch
+  // unit, 16 * (60 * 128 + 1536 * log2(frequency / 261.625))
+  // = 447827 - 24576 * log2(period).
+  int32_t log2_period = Log2(measurements) - Log2(num_measurements);
+  return 447827 - ((log2_period * 3) >> 3);
+}
+
+/* static */
+bool VoiceTuner::ComputeResponse() {
+  for (uint8_t i = 1; i < kNumTuningPoints; ++i) {
+    if (response_[i] <= response_[i - 1]) {
+      // The VCO is not responding, or not monotonically: keep the current
+      // calibration.
+      return false;
+    }
+  }
+  
+  // Resample the measured response on the regular pitch grid of the
+  // calibration table, extrapolating the first and last segments.
+  int16_t calibration[kNumVcoCvCalibrationPoints];
+  uint8_t segment = 0;
+  for (uint8_t i = 0; i < kNumVcoCvCalibrationPoints; ++i) {
+    int32_t pitch = static_cast<int32_t>(i) << (kVcoCvCalibrationShift + 4);
+    while (segment < kNumTuningPoints - 2 && pitch > response_[segment + 1]) {
+      ++segment;
+    }
+    int32_t cv = kTuningFirstPointCv + segment * kTuningPointCvSpacing;
+    cv += (pitch - response_[segment]) * kTuningPointCvSpacing / \
+        (response_[segment + 1] - response_[segment]);
+    // Keep the table within a range for which the differences between
+    // successive entries fit in 16 bits.
+    if (cv < -4096) {
+      cv = -4096;
+    } else if (cv > 8191) {
+      cv = 8191;
+    }
+    calibration[i] = cv;
+  }
+  system_settings.set_vco_cv_calibration(calibration);
+  return true;
 }
 
 void VoiceTuner::Refresh() {
   switch (tuning_state_) {
-    case TUNING_PROBING_C1:
-      voice_controller.mutable_voice()->Lock(1048, 0, 4095, 128);
-      if (num_pitch_measurements_ >= 8 + 8) {
-        pitch_c1_ = GetPitch();
-        SetTuningState(TUNING_PROBING_C3);
-      };
-      break;
-    
-    case TUNING_PROBING_C3:
-      voice_controller.mutable_voice()->Lock(2048, 0, 4095, 128);
-      if (num_pitch_measurements_ >= 8 + 16) {
-        pitch_c3_ = GetPitch();
-        SetTuningState(TUNING_PROBING_C5);
-      }
-      break;
-      
-    case TUNING_PROBING_C5:
-      voice_controller.mutable_voice()->Lock(3048, 0, 4095, 128);
-      if (num_pitch_measurements_ >= 8 + 32) {
-        pitch_c5_ = GetPitch();
-        tuning_timer_.StopInputCapture();
-        tuning_timer_.Stop();
-        dco_controller.Start();
-        SetTuningState(TUNING_COMPUTING_RESPONSE);
+    case TUNING_PROBING:
+      {
+        voice_controller.mutable_voice()->Lock(
+            kTuningFirstPointCv + point_ * kTuningPointCvSpacing,
+            0, 4095, 128);
+        
+        uint8_t sreg = SREG;
+        cli();
+        uint32_t measurements = pitch_measurements_;
+        uint16_t num_measurements = num_pitch_measurements_;
+        if (measurements >= kTuningWindowDuration) {
+          pitch_measurements_ = 0;
+          num_pitch_measurements_ = 0;
+        }
+        SREG = sreg;
+        if (measurements < kTuningWindowDuration) {
+          break;
+        }
+        
+        ++num_windows_;
+        int32_t pitch = MeasuredPitch(measurements, num_measurements);
+        int32_t delta = pitch - previous_window_pitch_;
+        bool converged = num_windows_ >= 2 && \
+            delta < kTuningConvergenceThreshold && \
+            delta > -kTuningConvergenceThreshold;
+        if (converged || num_windows_ >= kTuningMaxNumWindows) {
+          response_[point_] = MeasuredPitch(
+              measurements + previous_window_measurements_,
+              num_measurements + previous_window_num_measurements_);
+          if (point_ == kNumTuningPoints - 1) {
+            tuning_timer_.StopInputCapture();
+            tuning_timer_.Stop();
+            dco_controller.Start();
+            tuning_state_ = TUNING_COMPUTING_RESPONSE;
+          } else {
+            StartProbe(point_ + 1);
+          }
+        } else {
+          previous_window_pitch_ = pitch;
+          previous_window_measurements_ = measurements;
+          previous_window_num_measurements_ = num_measurements;
+        }
       }
       break;
     
     case TUNING_COMPUTING_RESPONSE:
-      {
-        // 2 * 64000.0 * math.log(2) / 3 = 29574.28
-        // 128.0 * 12.0 / math.log(2) = 2215.98
-        // midi2hz(60) = 261.625
-        uint16_t scale_low = static_cast<uint16_t>(
-            29574.28f / logf(pitch_c3_ / pitch_c1_));
-        uint16_t scale_high = static_cast<uint16_t>(
-            29574.28f / logf(pitch_c5_ / pitch_c3_));
-        uint16_t offset = 60 * 128 + static_cast<uint16_t>(
-            2215.98f * logf(pitch_c3_ / 261.625));
-        system_settings.set_calibration_data(offset, scale_low, scale_high);
-        // Fall through!
-      }
+      ComputeResponse();
+      // Fall through!
       
     case TUNING_ABORT:
       voice_controller.mutable_voice()->Unlock();
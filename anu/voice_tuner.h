@@ -24,13 +24,25 @@ namespace anu {
 
 enum TuningState {
   TUNING_OFF,
-  TUNING_PROBING_C1,
-  TUNING_PROBING_C3,
-  TUNING_PROBING_C5,
+  TUNING_PROBING,
   TUNING_COMPUTING_RESPONSE,
   TUNING_ABORT
 };
 
+// The VCO response is probed at kNumTuningPoints evenly spaced DAC codes. At
+// each point, the periods are summed over windows of at least
+// kTuningWindowDuration timer ticks (so that high notes are averaged over
+// more periods), and the probe moves on as soon as the pitches measured on two
+// successive windows agree within kTuningConvergenceThreshold (in 1/16th of
+// the 1/128th of semitone pitch unit).
+const uint8_t kNumTuningPoints = 9;
+const uint16_t kTuningFirstPointCv = 448;
+const uint16_t kTuningPointCvSpacing = 400;
+const uint32_t kTuningWindowDuration = 65536;
+const uint8_t kTuningMaxNumWindows = 16;
+const uint8_t kTuningNumDiscardedPeriods = 8;
+const int32_t kTuningConvergenceThreshold = 16;
+
 class VoiceTuner {
  public:
   VoiceTuner() { }
@@ -39,8 +51,10 @@ class VoiceTuner {
   static void Refresh();
   
   static void UpdatePitchMeasurement(uint32_t pitch_measurement) {
-    ++num_pitch_measurements_;
-    if (num_pitch_measurements_ > 8) {
+    if (num_discarded_periods_) {
+      --num_discarded_periods_;
+    } else {
+      ++num_pitch_measurements_;
       pitch_measurements_ += pitch_measurement;
     }
   }
@@ -50,19 +64,29 @@ class VoiceTuner {
   }
   static void StartTuning();
   static uint8_t tuning_state() { return tuning_state_; }
+  static inline bool running() { return tuning_state_ != TUNING_OFF; }
 
  private:
-  static void SetTuningState(uint8_t index);
-  static void Process();
-  static float GetPitch();
+  static void StartProbe(uint8_t point);
+  static int32_t Log2(uint32_t x);
+  static int32_t MeasuredPitch(
+      uint32_t measurements,
+      uint16_t num_measurements);
+  static bool ComputeResponse();
    
   static uint8_t tuning_state_;
-  static uint32_t pitch_measurements_;
-  static uint8_t num_pitch_measurements_;
+  static volatile uint32_t pitch_measurements_;
+  static volatile uint16_t num_pitch_measurements_;
+  static volatile uint8_t num_discarded_periods_;
+  
+  static uint8_t point_;
+  static uint8_t num_windows_;
+  static int32_t previous_window_pitch_;
+  static uint32_t previous_window_measurements_;
+  static uint16_t previous_window_num_measurements_;
   
-  static float pitch_c1_;
-  static float pitch_c3_;
-  static float pitch_c5_;
+  // Pitch measured at each probe point, in 1/16th of pitch unit.
+  static int32_t response_[kNumTuningPoints];
   
   static TuningTimer tuning_timer_;
   